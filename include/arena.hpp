@@ -0,0 +1,108 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+/**
+ * @file arena.hpp
+ * @brief Partidas bot contra bot sem interface (sem impressão nem pausas), em paralelo, com
+ *        placar e diferença de Elo entre os dois bots.
+ */
+
+#include <memory>
+#include <string>
+#include "botplayer.hpp"
+#include "jogos.hpp"
+
+/**
+ * @struct ConfiguracaoBot
+ * @brief Tipo e força de um bot da arena, lidos de textos como "alfabeta:6", "mcts:3000" ou "perfeito".
+ *
+ * Tipos: "alfabeta" (nivel = profundidade), "mcts" (só Reversi; nivel = simulações) e "perfeito"
+ * (Lig4 7x6 e Jogo da Velha 3x3: jogo perfeito, com nivel = profundidade de reserva).
+ */
+struct ConfiguracaoBot {
+    std::string tipo;
+    int nivel;  ///< 0 = padrão do bot
+
+    /// @throws std::invalid_argument Se o texto não estiver no formato "tipo" ou "tipo:nivel".
+    static ConfiguracaoBot ler(const std::string& texto);
+    std::string texto() const { return nivel > 0 ? tipo + ":" + std::to_string(nivel) : tipo; }
+};
+
+/**
+ * @struct ConfiguracaoArena
+ * @brief Jogo (mesma numeração da Partida: 1 - Jogo da Velha, 2 - Lig4, 3 - Reversi), tamanho do
+ *        tabuleiro, os dois bots e como as partidas são sorteadas e distribuídas.
+ */
+struct ConfiguracaoArena {
+    int tipoJogo = 3;
+    int linhas = 0;         ///< 0 = tamanho padrão do jogo
+    int colunas = 0;        ///< No Reversi, 0 ou igual a linhas (só tabuleiros quadrados)
+    int k = 3;              ///< Sequência para vencer no Jogo da Velha
+    ConfiguracaoBot bots[2] = {{"alfabeta", 4}, {"alfabeta", 4}};
+    int partidas = 100;
+    int threads = 1;
+    unsigned semente = 1;
+    int aberturaAleatoria = 4;  ///< Jogadas sorteadas no começo de cada par de partidas
+};
+
+/**
+ * @struct ResultadoArena
+ * @brief Placar do ponto de vista do bot A (bots[0]).
+ */
+struct ResultadoArena {
+    int vitorias = 0;
+    int empates = 0;
+    int derrotas = 0;
+    double segundos = 0.0;
+
+    int partidas() const { return vitorias + empates + derrotas; }
+    /// Fração dos pontos do bot A (vitória = 1, empate = 1/2).
+    double pontuacao() const;
+    /// Diferença de Elo de A para B estimada pela pontuação.
+    double elo() const;
+    /// Meia largura do intervalo de 95% da diferença de Elo.
+    double erroElo() const;
+    double partidasPorSegundo() const { return segundos > 0 ? partidas() / segundos : 0.0; }
+};
+
+/**
+ * @class Arena
+ * @brief Joga as partidas em paralelo: cada thread tem os seus dois bots e pega a próxima partida livre.
+ *
+ * As partidas vão em pares com a mesma abertura sorteada (semente + número do par), trocando os
+ * lados dos bots, para que nenhum dos dois se beneficie de quem começa. Os bots são criados de novo
+ * a cada partida, jogam em uma thread só e limitam as soluções exatas por número de nós, e não por
+ * prazo, então o placar depende só da semente, e não de qual thread jogou qual partida nem da carga
+ * da máquina.
+ */
+class Arena {
+public:
+    /// @throws std::invalid_argument Se o jogo ou algum bot não for válido para o jogo.
+    explicit Arena(const ConfiguracaoArena& configuracao);
+
+    ResultadoArena executar();
+
+    /// Cria o bot da configuração para o jogo indicado.
+    static std::unique_ptr<BotPlayer> criarBot(int tipoJogo, const ConfiguracaoBot& bot);
+    /// Novo tabuleiro do jogo da configuração.
+    std::unique_ptr<JogosDeTabuleiro> criarJogo() const;
+
+    /**
+     * @brief Joga uma partida até o fim, sem imprimir nada. Um bot que devolve uma jogada inválida perde.
+     * @param bots bots[0] joga com as peças 1 e bots[1] com as peças 2.
+     * @param jogador Quem joga primeiro a partir da posição atual.
+     * @return Vencedor (1 ou 2) ou 0 em caso de empate.
+     */
+    static int jogar(JogosDeTabuleiro& jogo, BotPlayer* bots[2], int jogador = 1);
+
+private:
+    ConfiguracaoArena configuracao_;
+
+    /**
+     * @brief Sorteia as jogadas iniciais do par "par", sem nenhuma que termine a partida.
+     * @return Jogador da vez depois da abertura.
+     */
+    int sortearAbertura(JogosDeTabuleiro& jogo, int par) const;
+};
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef BITBOARD_HPP
+#define BITBOARD_HPP
+
+/**
+ * @file bitboard.hpp
+ * @brief Representações compactas em bitboards (inteiros de 64 bits) para os jogos de tabuleiro.
+ */
+
+#include <cstdint>
+
+/**
+ * @class ReversiBitboard
+ * @brief Tabuleiro 8x8 de Reversi representado por dois inteiros de 64 bits, um por jogador.
+ *
+ * A casa (linha, coluna) corresponde ao bit linha * 8 + coluna. A geração de jogadas e o
+ * cálculo das peças viradas usam deslocamentos com preenchimento "occluded fill" (Kogge-Stone)
+ * nas 8 direções, sem percorrer o tabuleiro casa a casa.
+ */
+class ReversiBitboard {
+public:
+    ReversiBitboard() : pecas_{0, 0} {}
+
+    static int indice(int linha, int coluna) { return linha * 8 + coluna; }
+    static uint64_t bit(int linha, int coluna) { return 1ULL << indice(linha, coluna); }
+
+    uint64_t pecas(int jogador) const { return pecas_[jogador - 1]; }
+    uint64_t ocupadas() const { return pecas_[0] | pecas_[1]; }
+    uint64_t vazias() const { return ~ocupadas(); }
+    void set_pecas(int jogador, uint64_t pecas) { pecas_[jogador - 1] = pecas; }
+
+    /// Retorna 1 ou 2 se a casa pertence a um jogador, 0 se estiver vazia.
+    int get_casa(int indice) const;
+
+    /// Máscara com todas as casas onde o jogador pode jogar.
+    uint64_t jogadas_validas(int jogador) const {
+        return jogadas_validas(pecas(jogador), pecas(jogador == 1 ? 2 : 1));
+    }
+
+    /// Máscara das peças do oponente viradas por uma jogada na casa indicada (0 se inválida).
+    uint64_t calcular_viradas(int indice, int jogador) const {
+        return calcular_viradas(indice, pecas(jogador), pecas(jogador == 1 ? 2 : 1));
+    }
+
+    // Versões sobre as máscaras do jogador da vez e do oponente, sem o objeto (usadas pelas buscas)
+    static uint64_t jogadas_validas(uint64_t proprias, uint64_t oponente);
+    static uint64_t calcular_viradas(int indice, uint64_t proprias, uint64_t oponente);
+
+    /// Coloca a peça do jogador e vira as peças indicadas.
+    void aplicar(int indice, int jogador, uint64_t viradas);
+
+    /// Desfaz uma jogada aplicada anteriormente com aplicar().
+    void desfazer(int indice, int jogador, uint64_t viradas);
+
+    static int contar(uint64_t mascara) { return __builtin_popcountll(mascara); }
+
+private:
+    uint64_t pecas_[2];
+};
+
+/**
+ * @class Lig4Bitboard
+ * @brief Tabuleiro de Lig4 no formato clássico "posição/máscara" com uma linha sentinela.
+ *
+ * Cada coluna ocupa (linhas + 1) bits consecutivos, de baixo para cima; o bit extra do topo
+ * é a sentinela que impede que os deslocamentos "vazem" de uma coluna para a próxima.
+ * A máscara guarda todas as casas ocupadas e a posição guarda as peças do jogador 1; as
+ * peças do jogador 2 são mascara ^ posicao. Só pode ser usado quando (linhas + 1) * colunas <= 64.
+ */
+class Lig4Bitboard {
+public:
+    Lig4Bitboard(int linhas = 6, int colunas = 7);
+
+    /// Indica se um tabuleiro com essas dimensões cabe em 64 bits (incluindo a linha sentinela).
+    static bool cabe(int linhas, int colunas) {
+        return linhas > 0 && colunas > 0 && (linhas + 1) * colunas <= 64;
+    }
+
+    int getColunas() const { return colunas_; }
+    bool pode_jogar(int coluna) const { return (mascara_ & topo(coluna)) == 0; }
+
+    /**
+     * @brief Solta uma peça na coluna (uma única soma) e retorna a altura em que ela parou.
+     * @return Altura contada a partir de baixo (0 é a linha do fundo).
+     */
+    int jogar(int coluna, int jogador);
+
+    /// Remove a peça do topo da coluna.
+    void desfazer(int coluna);
+
+    uint64_t pecas(int jogador) const { return jogador == 1 ? posicao_ : (posicao_ ^ mascara_); }
+    uint64_t mascara() const { return mascara_; }
+    bool cheio() const { return mascara_ == cheio_; }
+
+    /// Verifica se o jogador tem quatro peças alinhadas.
+    bool alinhou(int jogador) const { return alinhado(pecas(jogador)); }
+
+    /// Retorna 1 ou 2 se algum jogador alinhou quatro peças, 0 caso contrário.
+    int vencedor() const;
+
+private:
+    int linhas_, colunas_;
+    uint64_t posicao_;  ///< Peças do jogador 1
+    uint64_t mascara_;  ///< Todas as casas ocupadas
+    uint64_t cheio_;    ///< Máscara com todas as casas jogáveis preenchidas
+
+    uint64_t base(int coluna) const { return 1ULL << (coluna * (linhas_ + 1)); }
+    uint64_t topo(int coluna) const { return 1ULL << (linhas_ - 1 + coluna * (linhas_ + 1)); }
+    uint64_t coluna_inteira(int coluna) const { return ((1ULL << linhas_) - 1) << (coluna * (linhas_ + 1)); }
+    bool alinhado(uint64_t pecas) const;
+};
+
+#endif
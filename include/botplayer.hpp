@@ -2,7 +2,13 @@
 #define BOTPLAYER_HPP
 #include <vector>
 #include <utility>
+#include <chrono>
+#include <string>
 #include "jogos.hpp"
+#include "busca.hpp"
+#include "solucionadorlig4.hpp"
+
+class ThreadPool;
 
 // Classe base abstrata para representar bots em jogos de tabuleiro
 class BotPlayer {
@@ -11,52 +17,232 @@ public:
 
     // Método abstrato para calcular a próxima jogada do bot
     virtual std::pair<int, int> calcularProximaJogada(
-        const JogosDeTabuleiro& jogo, 
+        const JogosDeTabuleiro& jogo,
         int jogadorAtual
     ) = 0;
 
+    /**
+     * @brief Calcula a próxima jogada respeitando um prazo e/ou orçamento de nós, com aprofundamento
+     *        iterativo. Sempre retorna a melhor jogada da última iteração completa.
+     */
+    virtual std::pair<int, int> calcularProximaJogada(
+        const JogosDeTabuleiro& jogo,
+        int jogadorAtual,
+        const LimiteBusca& limite
+    ) = 0;
+
+    /// Número de posições visitadas pela busca na última chamada de calcularProximaJogada.
+    long long getNosVisitados() const { return nosVisitados_; }
+    /// Profundidade da última iteração completada na última chamada de calcularProximaJogada.
+    int getProfundidadeAlcancada() const { return profundidadeAlcancada_; }
+
+    /// Altera o tamanho (em MB) da tabela de transposição usada pela busca.
+    void setTamanhoTabela(std::size_t megabytes) { tabela_.redimensionar(megabytes); }
+    std::size_t getTamanhoTabela() const { return tabela_.getMegabytes(); }
+
 protected:
     BotPlayer() = default;
     BotPlayer(const BotPlayer&) = delete;
     BotPlayer& operator=(const BotPlayer&) = delete;
+
+    static const int MAX_JOGADAS = 256;
+    static const int VITORIA = 1000000;
+    static const int INFINITO = 2 * VITORIA;
+
+    // Ganchos específicos de cada jogo usados pela busca negamax compartilhada.
+    // Todas as pontuações são do ponto de vista do jogador indicado.
+
+    /// Preenche "jogadas" com as jogadas válidas, já ordenadas da mais para a menos promissora.
+    virtual int gerarJogadas(const JogosDeTabuleiro& jogo, int jogador, std::pair<int, int>* jogadas) const = 0;
+    /// Avaliação heurística de uma posição que não é final.
+    virtual int avaliar(const JogosDeTabuleiro& jogo, int jogador) const = 0;
+    /// Retorna true se o jogo acabou, com +VITORIA, -VITORIA ou 0 (empate) em "pontuacao".
+    virtual bool fimDeJogo(const JogosDeTabuleiro& jogo, int jogador, int& pontuacao) const = 0;
+    /// Indica se o jogador sem jogadas válidas passa a vez (Reversi) em vez de o jogo terminar.
+    virtual bool permitePassar() const { return false; }
+
+    /**
+     * @brief Busca negamax com poda alfa-beta, fazendo e desfazendo jogadas sobre "jogo".
+     * @return Pontuação da posição do ponto de vista do jogador.
+     */
+    int negamax(JogosDeTabuleiro& jogo, int profundidade, int alfa, int beta, int jogador, int ply, ContextoBusca& contexto) const;
+
+    /**
+     * @brief Escolhe a melhor jogada aprofundando de 1 até o limite, tentando primeiro
+     *        a melhor jogada da iteração anterior.
+     * @return (-1, -1) se não houver jogadas válidas.
+     */
+    std::pair<int, int> buscarMelhorJogada(JogosDeTabuleiro& jogo, int jogador, const LimiteBusca& limite);
+
+    /**
+     * @brief Busca "Lazy SMP": uma busca por cópia do jogo, todas compartilhando a tabela de
+     *        transposição. A primeira roda na thread que chama; as demais, no pool.
+     * @param copias Uma cópia independente do jogo por thread.
+     * @return A jogada da thread que completou a iteração mais profunda.
+     */
+    std::pair<int, int> buscarEmParalelo(ThreadPool& pool, const std::vector<JogosDeTabuleiro*>& copias,
+                                         int jogador, const LimiteBusca& limite);
+
+    /// Chave da posição para a tabela de transposição: hash do tabuleiro mais o jogador da vez.
+    static uint64_t chavePosicao(const JogosDeTabuleiro& jogo, int jogador) {
+        return jogador == 2 ? jogo.get_hash() ^ 0xf3a9c6d1e5b70421ULL : jogo.get_hash();
+    }
+
+    TabelaTransposicao& tabela() { return tabela_; }
+
+    // Estatísticas da última busca, expostas por getNosVisitados() e getProfundidadeAlcancada()
+    long long nosVisitados_ = 0;
+    int profundidadeAlcancada_ = 0;
+
+private:
+    TabelaTransposicao tabela_;
+
+    /**
+     * @brief Laço de aprofundamento iterativo de uma thread. Threads auxiliares (auxiliar > 0) começam
+     *        em outra profundidade e com outra ordem na raiz, para não repetirem o trabalho da principal.
+     */
+    std::pair<int, int> aprofundar(JogosDeTabuleiro& jogo, int jogador, int auxiliar,
+                                   ContextoBusca& contexto, int& profundidadeAlcancada) const;
 };
 
 // Classe para implementar o bot do jogo Reversi
 class ReversiBot : public BotPlayer {
 public:
+    /**
+     * @param profundidade Profundidade da busca quando não há outro limite.
+     * @param pool Threads para a busca paralela (nullptr = busca apenas na thread que chama).
+     */
+    explicit ReversiBot(int profundidade = 6, ThreadPool* pool = nullptr);
+
+    /// Número de threads da busca, contando a que chama (1 = sequencial). Padrão: todas as do pool + 1.
+    void setThreads(int threads) { threads_ = threads < 1 ? 1 : threads; }
+    int getThreads() const { return threads_; }
+
+    /// Com até este número de casas vazias (tabuleiro 8x8), o final é resolvido de forma exata.
+    void setLimiarFinal(int vazias) { limiarFinal_ = vazias; }
+    int getLimiarFinal() const { return limiarFinal_; }
+    /**
+     * @brief Tempo máximo da solução exata do final quando o limite da jogada não tem prazo nem
+     *        orçamento de nós (como o porProfundidade padrão). Se estourar, vale a busca normal.
+     */
+    void setPrazoFinal(std::chrono::milliseconds prazo) { prazoFinal_ = prazo; }
+    std::chrono::milliseconds getPrazoFinal() const { return prazoFinal_; }
+    /// Com nós > 0, o limite padrão da solução exata é esse orçamento de nós em vez do prazo
+    /// (o resultado deixa de depender da velocidade e da carga da máquina).
+    void setNosFinal(long long nos) { nosFinal_ = nos; }
+    long long getNosFinal() const { return nosFinal_; }
+
     std::pair<int, int> calcularProximaJogada(
-        const JogosDeTabuleiro& jogo, 
+        const JogosDeTabuleiro& jogo,
         int jogadorAtual
     ) override;
+    std::pair<int, int> calcularProximaJogada(
+        const JogosDeTabuleiro& jogo,
+        int jogadorAtual,
+        const LimiteBusca& limite
+    ) override;
+
+protected:
+    int gerarJogadas(const JogosDeTabuleiro& jogo, int jogador, std::pair<int, int>* jogadas) const override;
+    int avaliar(const JogosDeTabuleiro& jogo, int jogador) const override;
+    bool fimDeJogo(const JogosDeTabuleiro& jogo, int jogador, int& pontuacao) const override;
+    bool permitePassar() const override { return true; }
+
+    ThreadPool* pool_;
+    int threads_;
+
+    /**
+     * @brief Resolve o final de forma exata se o tabuleiro for 8x8 e tiver no máximo getLimiarFinal() vazias.
+     * @param limite Prazo e/ou orçamento de nós; sem nenhum dos dois, vale getNosFinal() ou, se for 0,
+     *        getPrazoFinal().
+     * @param jogada Recebe a jogada perfeita.
+     * @return false se o final não se aplica ou se o limite estourou antes da solução.
+     */
+    bool resolverFinal(const Reversi& jogo, int jogador, const LimiteBusca& limite, std::pair<int, int>& jogada);
 
 private:
-    int _minimax(Reversi& jogo, int profundidade, bool maximizando, int jogadorAtual);
-    int _avaliarTabuleiro(const Reversi& jogo, int jogadorAtual);
+    int profundidade_;
+    int limiarFinal_;
+    std::chrono::milliseconds prazoFinal_;
+    long long nosFinal_;
+    int _avaliarTabuleiro(const Reversi& jogo, int jogadorAtual) const;
+    static int _pesoCasa(const JogosDeTabuleiro& jogo, int linha, int coluna);
 };
 
 // Classe para implementar o bot do jogo Lig 4
 class Lig4Bot : public BotPlayer {
 public:
+    explicit Lig4Bot(int profundidade = 9);
+
     std::pair<int, int> calcularProximaJogada(
-        const JogosDeTabuleiro& jogoBase, 
+        const JogosDeTabuleiro& jogoBase,
         int jogadorAtual
     ) override;
+    std::pair<int, int> calcularProximaJogada(
+        const JogosDeTabuleiro& jogoBase,
+        int jogadorAtual,
+        const LimiteBusca& limite
+    ) override;
+
+    /**
+     * @brief Liga o modo de jogo perfeito: no tabuleiro 7x6 a jogada vem do SolucionadorLig4.
+     *        Se a solução não terminar dentro do prazo, vale a busca heurística.
+     * @param prazo Tempo máximo do solucionador por jogada (sem outro limite informado).
+     */
+    void setModoPerfeito(bool ativo, std::chrono::milliseconds prazo = std::chrono::milliseconds(3000));
+    bool getModoPerfeito() const { return perfeito_; }
+    /// Com nós > 0, o solucionador usa esse orçamento de nós por jogada em vez do prazo (resultado
+    /// determinístico, independente da velocidade e da carga da máquina).
+    void setNosPerfeito(long long nos) { nosPerfeito_ = nos; }
+    long long getNosPerfeito() const { return nosPerfeito_; }
+    /// Carrega uma tabela de abertura para o modo perfeito (ver SolucionadorLig4::carregarAbertura).
+    bool carregarAbertura(const std::string& caminho) { return solucionador_.carregarAbertura(caminho); }
+
+protected:
+    int gerarJogadas(const JogosDeTabuleiro& jogo, int jogador, std::pair<int, int>* jogadas) const override;
+    int avaliar(const JogosDeTabuleiro& jogo, int jogador) const override;
+    bool fimDeJogo(const JogosDeTabuleiro& jogo, int jogador, int& pontuacao) const override;
+
 private:
-    int minimax(Lig4& jogo, int profundidade, bool maximizando, int jogadorAtual);
-    bool tabuleiroCheio(const Lig4& jogo);
+    int profundidade_;
+    bool perfeito_;
+    std::chrono::milliseconds prazoPerfeito_;
+    long long nosPerfeito_;
+    SolucionadorLig4 solucionador_;
+
+    bool resolverPerfeito(const Lig4& jogo, int jogador, const LimiteBusca& limite, int& coluna);
 };
 
-// Classe para implementar o bot do jogo da velha
+// Classe para implementar o bot do jogo da velha (qualquer m,n,k)
 class JogoDaVelhaBot : public BotPlayer {
 public:
+    /// @param profundidade Profundidade da busca nos tabuleiros com mais de CASAS_BUSCA_COMPLETA casas.
+    explicit JogoDaVelhaBot(int profundidade = 4);
+
     std::pair<int, int> calcularProximaJogada(
-        const JogosDeTabuleiro& jogoBase, 
+        const JogosDeTabuleiro& jogoBase,
         int jogadorAtual
     ) override;
+    std::pair<int, int> calcularProximaJogada(
+        const JogosDeTabuleiro& jogoBase,
+        int jogadorAtual,
+        const LimiteBusca& limite
+    ) override;
+
+protected:
+    int gerarJogadas(const JogosDeTabuleiro& jogo, int jogador, std::pair<int, int>* jogadas) const override;
+    int avaliar(const JogosDeTabuleiro& jogo, int jogador) const override;
+    bool fimDeJogo(const JogosDeTabuleiro& jogo, int jogador, int& pontuacao) const override;
 
 private:
-    void minimax(const JogoDaVelha& jogo, int& melhorLinha, int& melhorColuna, int jogador);
-    int _minimax(JogoDaVelha& jogo, int profundidade, bool maximizando, int jogador);
+    /// Tabuleiros com até esta quantidade de casas são buscados até o fim do jogo.
+    static const int CASAS_BUSCA_COMPLETA = 16;
+    int profundidade_;
+
+    static int pesoSequencia(int pecas, int k);
+    /// Jogada perfeita do tabuleiro 3x3 pela TabelaVelha, calculada em tempo de compilação.
+    bool consultarTabela(const JogosDeTabuleiro& jogo, int jogador, const LimiteBusca& limite,
+                         std::pair<int, int>& jogada);
 };
 
 #endif
@@ -0,0 +1,77 @@
+#ifndef BUSCA_HPP
+#define BUSCA_HPP
+
+/**
+ * @file busca.hpp
+ * @brief Limites e estado compartilhados pelas buscas dos bots e pelos solucionadores exatos.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <utility>
+#include "transposicao.hpp"
+
+/**
+ * @struct LimiteBusca
+ * @brief Até onde a busca pode ir: profundidade máxima, prazo (relógio monotônico) e/ou número de nós.
+ */
+struct LimiteBusca {
+    typedef std::chrono::steady_clock Relogio;
+
+    int profundidade;         ///< Profundidade máxima, contando a jogada da raiz
+    Relogio::time_point prazo; ///< Relogio::time_point::max() = sem prazo
+    long long maxNos;         ///< 0 = sem limite de nós
+
+    LimiteBusca() : profundidade(127), prazo(Relogio::time_point::max()), maxNos(0) {}
+
+    static LimiteBusca porProfundidade(int profundidade) {
+        LimiteBusca limite;
+        limite.profundidade = profundidade;
+        return limite;
+    }
+    static LimiteBusca porTempo(std::chrono::milliseconds tempo) {
+        LimiteBusca limite;
+        limite.prazo = Relogio::now() + tempo;
+        return limite;
+    }
+    static LimiteBusca porNos(long long nos) {
+        LimiteBusca limite;
+        limite.maxNos = nos;
+        return limite;
+    }
+};
+
+/**
+ * @struct ContextoBusca
+ * @brief Estado de uma busca: contador de nós, jogadas "assassinas" (que causaram cortes) por nível
+ *        e o limite que, quando estourado, interrompe a busca.
+ *
+ * Na busca paralela cada thread tem o seu contexto; só a tabela e o sinal "parar" são compartilhados.
+ */
+struct ContextoBusca {
+    static const int MAX_PLY = 128;
+
+    long long nos = 0;
+    std::pair<int, int> assassinas[MAX_PLY];
+    TabelaTransposicao* tabela = nullptr;
+    const LimiteBusca* limite = nullptr;
+    const std::atomic<bool>* parar = nullptr; ///< Sinal externo de interrupção (busca paralela)
+    bool abortada = false;
+
+    ContextoBusca() {
+        for (int i = 0; i < MAX_PLY; i++) assassinas[i] = std::make_pair(-1, -1);
+    }
+
+    /// Verifica o limite a cada 256 nós (consultar o relógio em todo nó custaria caro).
+    bool deveParar() {
+        if (!abortada && (nos & 255) == 0) {
+            abortada = (parar && parar->load(std::memory_order_relaxed)) ||
+                       (limite && limite->maxNos > 0 && nos >= limite->maxNos) ||
+                       (limite && limite->prazo != LimiteBusca::Relogio::time_point::max() &&
+                        LimiteBusca::Relogio::now() >= limite->prazo);
+        }
+        return abortada;
+    }
+};
+
+#endif
@@ -13,6 +13,14 @@
 #include <fstream> 
 #include <memory>
 #include <algorithm>
+#include <unordered_map>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+class ThreadPool;
 
 /**
  * @struct Winrate
@@ -63,22 +71,76 @@ public:
     
     void setNome(const std::string& nome) { _nome = nome; }
     void setApelido(const std::string& apelido) { _apelido = apelido; }
+    void setNome(const char* nome, std::size_t tamanho) { _nome.assign(nome, tamanho); }
+    void setApelido(const char* apelido, std::size_t tamanho) { _apelido.assign(apelido, tamanho); }
     void setVitorias(Winrate& jogo, int vitorias) { jogo._vitorias = vitorias; }
     void setDerrotas(Winrate& jogo, int derrotas) { jogo._derrotas = derrotas; }
 
     std::string serializar() const;
     static Jogador deserializar(const std::string& linha);
+    /**
+     * @brief Lê uma linha serializada (de inicio até fim, sem o '\n') neste jogador, sem cópias
+     *        intermediárias; nome e apelido reaproveitam a memória que já tiverem.
+     * @throw std::runtime_error Com as mesmas mensagens de deserializar; o jogador não muda.
+     */
+    void preencher(const char* inicio, const char* fim);
 };
 
 /**
  * @class Cadastro
  * @brief Gerencia o cadastro de jogadores, incluindo adição, remoção e persistência de dados.
+ *
+ * Um índice por apelido deixa a busca, a adição e a remoção em tempo constante. A remoção troca o
+ * jogador removido pelo último da lista, então a ordem da listagem muda depois de uma remoção.
+ *
+ * Com o diário aberto (abrirDiario), cada alteração acrescenta uma linha ao arquivo "<caminho>.diario"
+ * em vez de regravar o cadastro inteiro: "+,<jogador>" (adição), "-,<apelido>" (remoção) e
+ * "=,<jogador>" (novo placar). O import aplica o diário depois do arquivo principal, e o save
+ * (compactação) grava o arquivo principal e esvazia o diário.
+ *
+ * O save grava um arquivo temporário, sincroniza com o disco e o renomeia por cima do anterior: uma
+ * queda no meio deixa o arquivo antigo inteiro. Os registros do diário são sincronizados em grupo:
+ * com um intervalo de sincronização, os registros que chegam dentro do intervalo vão para o disco
+ * juntos, com um único fsync, feito por uma thread em segundo plano.
  */
 class Cadastro {
 private:
     std::vector<std::unique_ptr<Jogador>> _jogadores; ///< Vetor de ponteiros únicos para os jogadores cadastrados.
+    std::unordered_map<std::string, std::size_t> _indice; ///< Apelido -> posição do jogador em _jogadores.
+    bool _verboso = true; ///< Imprime as mensagens de sucesso (desligado no modo em lote).
+    std::string _caminho;          ///< Arquivo principal do diário aberto (vazio = sem diário).
+    int _diario = -1;              ///< Descritor do diário aberto.
+    std::size_t _registrosDiario = 0; ///< Registros no diário desde a última compactação.
+
+    // Sincronização em grupo: _pendente guarda os registros ainda não gravados
+    std::string _pendente;
+    std::string _erroDiario;       ///< Falha da thread de sincronização, relatada no próximo registro
+    std::chrono::milliseconds _intervalo{0};
+    std::atomic<long long> _sincronizacoes{0};
+    bool _parar = false;
+    std::mutex _mutexPendente;     ///< Protege _pendente, _erroDiario e _parar
+    std::mutex _mutexArquivo;      ///< Ordena as gravações no diário
+    std::condition_variable _sinal;
+    std::thread _sincronizador;
+
+    void inserir(std::unique_ptr<Jogador> jogador);
+    void retirar(std::size_t posicao);
+    void registrar(char tipo, const std::string& conteudo);
+    void aplicarDiario(const std::string& caminho);
+    void gravarPendentes();
+    void executarSincronizador();
+    void fecharDiario();
+    void gravar(const std::string& caminho, bool binario);
 
 public:
+    /// O diário é compactado quando passa deste número de registros e do número de jogadores.
+    static const std::size_t MIN_REGISTROS_DIARIO = 1024;
+
+    Cadastro() = default;
+    ~Cadastro();
+    Cadastro(const Cadastro&) = delete;
+    Cadastro& operator=(const Cadastro&) = delete;
+
     /**
      * 
      */
@@ -86,9 +148,37 @@ public:
     void adicionarJogador(const Jogador& alvo);
     void mostrarJogadores() const;
     void import(const std::string& caminho);
+    /// Mesmo resultado do import, com o arquivo mapeado em memória e lido em paralelo pelo pool.
+    void import(const std::string& caminho, ThreadPool& pool);
     void save(const std::string& caminho);
+    /// Mesmo que import e save, no formato binário de cadastrobinario.hpp.
+    void importBinario(const std::string& caminho);
+    void saveBinario(const std::string& caminho);
     void removeJogador(const Jogador& alvo);
     bool check(const Jogador& alvo) const;
+    /// Jogador com o apelido dado, ou nullptr se não estiver cadastrado (válido até a sua remoção).
+    Jogador* find(const std::string& apelido) const;
+    void setVerboso(bool verboso) { _verboso = verboso; }
+
+    /// Passa a registrar as alterações no diário de "caminho" (o arquivo principal).
+    void abrirDiario(const std::string& caminho);
+    /// Registra no diário o placar atual de um jogador cadastrado, alterado fora do Cadastro.
+    void registrarAlteracao(const Jogador& jogador);
+    /// Grava o arquivo principal do diário aberto e esvazia o diário.
+    void compactar();
+    static std::string caminhoDiario(const std::string& caminho) { return caminho + ".diario"; }
+    std::size_t getRegistrosDiario() const { return _registrosDiario; }
+
+    /**
+     * @brief Define de quanto em quanto tempo os registros do diário vão para o disco.
+     * @param intervalo 0 (padrão) sincroniza cada registro antes de retornar; acima de 0, uma queda
+     *        pode perder os registros do último intervalo.
+     */
+    void setIntervaloSincronizacao(std::chrono::milliseconds intervalo);
+    /// Grava e sincroniza agora os registros pendentes do diário.
+    void sincronizar();
+    /// Número de fsyncs feitos no diário (cada um confirma um grupo de registros).
+    long long getSincronizacoes() const { return _sincronizacoes; }
 };
 
 #endif
@@ -0,0 +1,85 @@
+#ifndef CADASTROBINARIO_HPP
+#define CADASTROBINARIO_HPP
+
+/**
+ * @file cadastrobinario.hpp
+ * @brief Formato binário do arquivo de cadastro, lido direto de um mapeamento em memória: abrir o
+ *        arquivo não lê os jogadores, e cada jogador é acessado pela posição ou pelo apelido sem
+ *        interpretar texto.
+ *
+ * Versão 1 (inteiros de 32 bits sem sinal, little-endian):
+ *  - Cabeçalho (32 bytes): "CADB", versão, quantidade de jogadores, tamanho de um registro, posição
+ *    dos registros, posição do índice, posição e tamanho da área de textos.
+ *  - Registros (40 bytes cada, na ordem do cadastro): posição e tamanho do nome e do apelido na área
+ *    de textos, seguidos de vitórias e derrotas no Jogo da Velha, no Lig4 e no Reversi.
+ *  - Índice: o número de cada registro, em ordem crescente de apelido (comparado byte a byte).
+ *  - Área de textos: nomes e apelidos, sem separadores.
+ *
+ * Um leitor aceita registros maiores que os da sua versão e ignora os campos que não conhece.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "cadastro.hpp"
+
+/**
+ * @class CadastroBinario
+ * @brief Arquivo de cadastro binário aberto para leitura. Só o cabeçalho é conferido ao abrir; os
+ *        limites de cada registro são conferidos quando ele é lido.
+ */
+class CadastroBinario {
+public:
+    static const std::uint32_t VERSAO = 1;
+    static const std::size_t TAMANHO_CABECALHO = 32;
+    static const std::size_t TAMANHO_REGISTRO = 40;
+
+    /// @throw std::runtime_error Se o arquivo não puder ser aberto ou não estiver no formato binário.
+    explicit CadastroBinario(const std::string& caminho);
+    ~CadastroBinario();
+    CadastroBinario(const CadastroBinario&) = delete;
+    CadastroBinario& operator=(const CadastroBinario&) = delete;
+
+    std::size_t tamanho() const { return _quantidade; }
+
+    /**
+     * @brief Lê o jogador da posição dada (na ordem do cadastro) no jogador informado, reaproveitando
+     *        a memória do nome e do apelido.
+     * @throw std::out_of_range Se a posição não existir.
+     * @throw std::runtime_error Se o registro apontar para fora do arquivo.
+     */
+    void ler(std::size_t posicao, Jogador& jogador) const;
+    Jogador jogador(std::size_t posicao) const;
+
+    /**
+     * @brief Busca binária pelo apelido no índice, sem criar strings.
+     * @return Posição do jogador, ou -1 se o apelido não estiver no arquivo.
+     */
+    long procurar(const std::string& apelido) const;
+
+    /**
+     * @brief Codifica os jogadores no formato binário (o conteúdo inteiro do arquivo).
+     * @throw std::runtime_error Se algum placar for negativo ou o arquivo passar de 4 GiB.
+     */
+    static std::string codificar(const std::vector<std::unique_ptr<Jogador>>& jogadores);
+    /// Verifica se o arquivo começa com a assinatura do formato binário.
+    static bool reconhecer(const std::string& caminho);
+
+private:
+    const unsigned char* _dados = nullptr;
+    std::size_t _tamanhoArquivo = 0;
+    std::size_t _quantidade = 0;
+    std::size_t _tamanhoRegistro = 0;
+    const unsigned char* _registros = nullptr;
+    const unsigned char* _indice = nullptr;
+    const unsigned char* _textos = nullptr;
+    std::size_t _tamanhoTextos = 0;
+
+    const unsigned char* registro(std::size_t posicao) const;
+    /// Texto (nome ou apelido) cuja posição e tamanho estão no campo dado do registro.
+    const char* texto(const unsigned char* campo, std::size_t& tamanho) const;
+};
+
+#endif
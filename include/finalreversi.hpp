@@ -0,0 +1,46 @@
+#ifndef FINALREVERSI_HPP
+#define FINALREVERSI_HPP
+
+/**
+ * @file finalreversi.hpp
+ * @brief Solução exata dos finais de Reversi 8x8 (poucas casas vazias) sobre bitboards.
+ */
+
+#include <cstdint>
+#include "bitboard.hpp"
+#include "busca.hpp"
+
+/**
+ * @class SolucionadorFinalReversi
+ * @brief Busca até o fim do jogo e devolve a diferença final de peças com jogo perfeito dos dois lados.
+ *
+ * Trabalha só com as máscaras (próprias, oponente) do jogador da vez, sem tabuleiro genérico.
+ * A ordenação das jogadas prefere as regiões (quadrantes) com número ímpar de casas vazias e,
+ * com mais vazias, as jogadas que deixam o oponente com menos respostas ("fastest-first").
+ * As últimas 1 a 4 casas têm rotinas próprias, que testam cada casa vazia sem gerar jogadas.
+ */
+class SolucionadorFinalReversi {
+public:
+    /// @param contexto Conta os nós e interrompe a busca quando o limite dele estoura.
+    explicit SolucionadorFinalReversi(ContextoBusca& contexto) : contexto_(contexto) {}
+
+    /**
+     * @brief Resolve a posição com "proprias" na vez.
+     * @param melhorCasa Recebe a casa (linha * 8 + coluna) da melhor jogada, ou -1 se não houver jogadas.
+     * @return Peças próprias menos peças do oponente ao fim do jogo (sem valor se a busca foi interrompida).
+     */
+    int resolver(uint64_t proprias, uint64_t oponente, int& melhorCasa);
+
+private:
+    ContextoBusca& contexto_;
+
+    int buscar(uint64_t proprias, uint64_t oponente, int alfa, int beta, bool passou);
+    int ordenarJogadas(uint64_t proprias, uint64_t oponente, uint64_t jogadas, int* casas) const;
+
+    int final1(uint64_t proprias, uint64_t oponente, int x1);
+    int final2(uint64_t proprias, uint64_t oponente, int alfa, int beta, int x1, int x2, bool passou);
+    int final3(uint64_t proprias, uint64_t oponente, int alfa, int beta, int x1, int x2, int x3, bool passou);
+    int final4(uint64_t proprias, uint64_t oponente, int alfa, int beta, int x1, int x2, int x3, int x4, bool passou);
+};
+
+#endif
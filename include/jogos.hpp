@@ -2,7 +2,39 @@
 #define JOGOS_HPP
 #include <iostream>
 #include <vector>
+#include <cstdint>
 #include "cores.hpp"
+#include "bitboard.hpp"
+
+/**
+ * @struct RegistroJogada
+ * @brief Informações necessárias para desfazer uma jogada feita com fazer_jogada().
+ *
+ * Não aloca memória: as peças viradas no Reversi ficam numa máscara de 64 bits (tabuleiros 8x8)
+ * ou na contagem de peças viradas em cada uma das 8 direções (demais tamanhos). No Lig4 a linha
+ * registrada é a altura em que a peça parou na coluna.
+ */
+struct RegistroJogada {
+    int linha;
+    int coluna;
+    int jogador;
+    uint64_t viradas;                ///< Reversi 8x8: peças viradas pela jogada
+    uint8_t viradas_por_direcao[8];  ///< Reversi genérico: peças viradas em cada direção
+};
+
+/**
+ * @struct VisaoTabuleiro
+ * @brief Visão somente leitura (não proprietária) das casas de um tabuleiro, em ordem linha a linha.
+ *
+ * Continua válida enquanto o tabuleiro existir e não for redimensionado.
+ */
+struct VisaoTabuleiro {
+    const int8_t* celulas;
+    int linhas;
+    int colunas;
+
+    int8_t operator()(int linha, int coluna) const { return celulas[linha * colunas + coluna]; }
+};
 
 class JogosDeTabuleiro {
 public:
@@ -11,9 +43,16 @@ public:
     
     int getLinhas() const;
     int getColunas() const;
+    /// Cópia do tabuleiro como matriz; para leitura sem cópia use visao() ou at().
     std::vector<std::vector<int>> get_tabuleiro() const;
+    VisaoTabuleiro visao() const { return VisaoTabuleiro{dados(), linhas_, colunas_}; }
     char get_casa(int linha, int coluna) const;
-    void setLinhasColunas(int linha, int coluna);
+    /// Acesso sem verificação de limites, para laços internos.
+    int8_t at(int linha, int coluna) const { return dados()[linha * colunas_ + coluna]; }
+
+    /// Hash Zobrist do tabuleiro, atualizado incrementalmente a cada casa alterada.
+    uint64_t get_hash() const { return hash_; }
+    static uint64_t chave_zobrist(int casa, int jogador);
 
     virtual int imprimir_vetor(int jogador) const = 0;
     virtual int ler_jogada(int linha, int coluna, int jogador) = 0;
@@ -22,35 +61,98 @@ public:
     virtual int determinar_vencedor() const = 0; 
     virtual int anunciar_vencedor() const = 0;
 
+    /**
+     * @brief Faz uma jogada guardando o necessário para desfazê-la depois.
+     * @return false (sem alterar o tabuleiro) se a jogada for inválida.
+     */
+    virtual bool fazer_jogada(int linha, int coluna, int jogador, RegistroJogada& registro) = 0;
+    /// Desfaz a última jogada feita com fazer_jogada(), restaurando o tabuleiro anterior.
+    virtual void desfazer_jogada(const RegistroJogada& registro) = 0;
+
 
 protected:  
     int linhas_, colunas_;
-    std::vector<std::vector<int>> Tabuleiro_;
+
+    /// Altera uma casa (0 = vazia) mantendo o hash Zobrist em dia; toda escrita no tabuleiro passa por aqui.
+    void definir_casa(int linha, int coluna, int valor);
+    const int8_t* dados() const { return celulas_externas_.empty() ? celulas_locais_ : celulas_externas_.data(); }
+
+private:
+    uint64_t hash_;
+    int8_t* dados() { return celulas_externas_.empty() ? celulas_locais_ : celulas_externas_.data(); }
+    // Tabuleiros de até 64 casas ficam dentro do próprio objeto (sem alocação);
+    // maiores usam um único bloco contíguo no heap.
+    static const int CAPACIDADE_LOCAL = 64;
+    int8_t celulas_locais_[CAPACIDADE_LOCAL];
+    std::vector<int8_t> celulas_externas_;
+
+    void alocar_celulas();
 };
 
 class Reversi : public JogosDeTabuleiro {
 public:
-    Reversi(int linhas = 8, int colunas = 8);
+    /// @param bitboard false força a verificação casa a casa mesmo no 8x8 (implementação de referência).
+    Reversi(int linhas = 8, int colunas = 8, bool bitboard = true);
     int ler_jogada(int linha, int coluna, int jogador) override;
     bool verificar_jogada(int linha, int coluna, int jogador) const override;
     bool testar_condicao_de_vitoria() const override;
     std::vector<std::vector<bool>> atualizar_jogadas_validas(int jogador) const;
+    /// Indica se o jogador tem alguma jogada válida. O resultado fica guardado até a próxima jogada.
+    bool tem_jogadas(int jogador) const;
+    /**
+     * @brief Máscara das jogadas válidas do jogador, guardada até a próxima jogada.
+     * @throw std::logic_error Se o tabuleiro não usar bitboard (usa_bitboard() falso: tamanho diferente
+     *        de 8x8 ou tabuleiro de referência); nesse caso use verificar_jogada ou tem_jogadas.
+     */
+    uint64_t mascara_jogadas(int jogador) const;
+    bool usa_bitboard() const { return usa_bitboard_; }
     int imprimir_vetor(int jogador) const override;
     std::pair<int, int> calcular_pontuacao() const;
     void mostrar_pontuacao() const;
     int determinar_vencedor() const override; 
     int anunciar_vencedor() const override;
+    bool fazer_jogada(int linha, int coluna, int jogador, RegistroJogada& registro) override;
+    void desfazer_jogada(const RegistroJogada& registro) override;
 private:
     static const std::vector<std::pair<int, int>> direcoes;
-    std::vector<std::vector<bool>> JogadasValidas_;
+    bool usa_bitboard_;      ///< true quando o tabuleiro é 8x8 e pode ser representado em bitboards
+    ReversiBitboard bits_;   ///< Cópia do tabuleiro em bitboards, mantida em sincronia com as casas do tabuleiro
+
+    // Cache das jogadas válidas de cada jogador: calculadas na primeira consulta e descartadas a cada
+    // jogada (fazer_jogada/desfazer_jogada). Não há atualização incremental (fronteira ou máscara):
+    // o cálculo por bitboard cobre as 64 casas em poucas dezenas de ns, e a busca consulta cada
+    // posição logo após fazer_jogada, sem voltar a ela depois de desfazer_jogada. Como as consultas
+    // são const, um mesmo objeto não deve ser consultado por várias threads ao mesmo tempo.
+    mutable uint64_t mascaras_[2];
+    mutable bool mascaraValida_[2];
+    mutable int8_t temJogadas_[2];   ///< -1 = ainda não calculado
+    void invalidar_jogadas() {
+        mascaraValida_[0] = mascaraValida_[1] = false;
+        temJogadas_[0] = temJogadas_[1] = -1;
+    }
     bool verificar_direcao(int linha, int coluna, int dLinha, int dColuna, int jogador) const;
 };
 
+/**
+ * @class JogoDaVelha
+ * @brief Jogo m,n,k: tabuleiro de linhas x colunas em que vence quem alinhar k peças
+ *        (3x3 com k = 3 é o jogo da velha clássico; 15x15 com k = 5 é o gomoku).
+ *
+ * O vencedor e o número de casas ocupadas são atualizados a cada jogada, contando apenas as
+ * sequências que passam pela casa jogada (O(k)), sem varrer o tabuleiro.
+ */
 class JogoDaVelha : public JogosDeTabuleiro {
 public:
-    // Construtor padrão com tamanho 3x3
-    JogoDaVelha(int linhas = 3, int colunas = 3);
-    
+    /**
+     * @param k Peças em sequência para vencer.
+     * @throws std::invalid_argument Se k < 1 ou se k não cabe em nenhuma direção do tabuleiro.
+     */
+    JogoDaVelha(int linhas = 3, int colunas = 3, int k = 3);
+
+    int getK() const { return k_; }
+    /// Comprimento da sequência do jogador que passa por (linha, coluna) na direção (dLinha, dColuna), até k.
+    int contar_sequencia(int linha, int coluna, int dLinha, int dColuna, int jogador) const;
+
     // Métodos herdados e sobrescritos da classe base
     int ler_jogada(int linha, int coluna, int jogador) override;
     bool verificar_jogada(int linha, int coluna, int jogador) const override;
@@ -58,12 +160,20 @@ public:
     int imprimir_vetor(int jogador) const override;
     int anunciar_vencedor() const override;
     int determinar_vencedor() const override; // Retorna 1 para X, 2 para O, 0 para empate
+    bool fazer_jogada(int linha, int coluna, int jogador, RegistroJogada& registro) override;
+    void desfazer_jogada(const RegistroJogada& registro) override;
+private:
+    int k_;
+    int ocupadas_;          ///< Casas ocupadas (tabuleiro cheio = empate)
+    int vencedor_;          ///< Primeiro jogador a alinhar k peças (0 = ninguém)
+    int casaVencedora_;     ///< Casa da jogada que definiu vencedor_, para desfazê-la
 };
 
 class Lig4 : public JogosDeTabuleiro{
 public:
 
-    Lig4(int linhas = 6, int colunas = 7);
+    /// @param bitboard false força o tabuleiro casa a casa mesmo quando caberia em 64 bits (referência).
+    Lig4(int linhas = 6, int colunas = 7, bool bitboard = true);
 
     int ler_jogada(int linha, int coluna, int jogador) override;
     bool verificar_jogada(int linha, int coluna, int jogador) const override;
@@ -71,6 +181,18 @@ public:
     int imprimir_vetor(int jogador) const override;
     int anunciar_vencedor() const override;
     int determinar_vencedor() const override;
+    bool fazer_jogada(int linha, int coluna, int jogador, RegistroJogada& registro) override;
+    void desfazer_jogada(const RegistroJogada& registro) override;
+    /// Varre o tabuleiro inteiro atrás de quatro em linha; serve apenas para validar o vencedor incremental.
+    int vencedor_por_varredura() const;
+private:
+    bool usa_bitboard_;      ///< true quando o tabuleiro (com a linha sentinela) cabe em 64 bits
+    Lig4Bitboard bits_;      ///< Cópia do tabuleiro em bitboards, mantida em sincronia com as casas do tabuleiro
+    // Tabuleiros sem bitboard: o vencedor é verificado só nas quatro linhas que passam pela última peça
+    int ocupadas_;
+    int vencedor_;           ///< Primeiro jogador a alinhar quatro peças (0 = ninguém)
+    int casaVencedora_;      ///< Casa da jogada que definiu vencedor_, para desfazê-la
+    bool alinhou_em(int linha, int coluna, int jogador) const;
 };
 
 #endif
@@ -0,0 +1,62 @@
+#ifndef LOTE_HPP
+#define LOTE_HPP
+
+/**
+ * @file lote.hpp
+ * @brief Modo em lote (não interativo) do programa principal: executa um arquivo de comandos, ou a
+ *        entrada padrão, sem menus nem cores e salvando o cadastro só no fim ou a cada checkpoint.
+ *
+ * Um comando por linha (linhas vazias e as que começam com '#' são ignoradas):
+ *  - CJ <apelido> <nome completo>    cadastra um jogador
+ *  - RJ <apelido>                    remove um jogador
+ *  - LJ                              lista os jogadores, um por linha, no formato do arquivo de cadastro
+ *  - EP <V|L|R> <apelido1> <apelido2> <jogadas...>
+ *                                    executa uma partida completa e registra o resultado. Cada jogada é
+ *                                    "linha coluna" (a partir de 1); no Lig4, só a coluna. As passadas
+ *                                    de vez do Reversi são automáticas.
+ */
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include "cadastro.hpp"
+
+/**
+ * @class Lote
+ * @brief Executa os comandos em lote sobre um Cadastro. Um comando com erro é relatado (com o número
+ *        da linha) e não altera o cadastro; a execução continua na linha seguinte.
+ */
+class Lote {
+public:
+    /**
+     * @param jogadores Cadastro sobre o qual os comandos são executados.
+     * @param caminho Arquivo onde o cadastro é salvo.
+     * @param checkpoint Salva a cada "checkpoint" comandos que alteram o cadastro (0 = só no fim).
+     */
+    Lote(Cadastro& jogadores, const std::string& caminho, int checkpoint = 0);
+
+    /**
+     * @brief Executa todos os comandos da entrada e salva o cadastro no fim, se algo mudou.
+     * @param saida Recebe a listagem do LJ e as mensagens de erro.
+     * @return Número de comandos com erro.
+     */
+    int executar(std::istream& entrada, std::ostream& saida);
+
+    int getComandos() const { return comandos_; }
+    int getErros() const { return erros_; }
+
+private:
+    Cadastro& jogadores_;
+    std::string caminho_;
+    int checkpoint_;
+    int comandos_;
+    int erros_;
+    int alteracoesPendentes_;  ///< Comandos que alteraram o cadastro desde o último salvamento
+
+    /// @throws std::invalid_argument Se o comando ou os seus argumentos forem inválidos.
+    void executarComando(const std::vector<std::string>& campos, std::ostream& saida);
+    void executarPartida(const std::vector<std::string>& campos);
+    void salvarSePendente();
+};
+
+#endif
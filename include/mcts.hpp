@@ -0,0 +1,81 @@
+#ifndef MCTS_HPP
+#define MCTS_HPP
+
+/**
+ * @file mcts.hpp
+ * @brief Bot de Reversi por busca em árvore Monte Carlo (MCTS) com seleção UCT.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "botplayer.hpp"
+
+/**
+ * @struct NoMCTS
+ * @brief Nó da árvore MCTS, guardado na arena do bot e ligado aos irmãos por índices.
+ */
+struct NoMCTS {
+    static const int8_t PASSE = -1;  ///< "Casa" do nó que representa passar a vez
+
+    uint64_t pendentes;      ///< Jogadas válidas que ainda não viraram filhos deste nó
+    int32_t primeiroFilho;   ///< Índice na arena (-1 se nenhum)
+    int32_t proximoIrmao;    ///< Índice na arena (-1 se nenhum)
+    uint32_t visitas;        ///< Inclui as visitas em andamento (perda virtual)
+    float vitorias;          ///< Do ponto de vista de quem fez a jogada que leva a este nó (empate = 0,5)
+    int8_t casa;             ///< Casa (linha * 8 + coluna) da jogada que leva a este nó, ou PASSE
+    uint8_t jogador;         ///< Quem fez a jogada que leva a este nó
+    bool passePendente;      ///< O jogador da vez não tem jogadas, mas o jogo continua
+};
+
+/**
+ * @class MCTSReversiBot
+ * @brief Bot de Reversi que escolhe a jogada por simulações aleatórias até o fim do jogo.
+ *
+ * Cada simulação desce pela árvore escolhendo o filho de maior UCT, expande um nó novo e
+ * termina a partida com jogadas aleatórias sobre um ReversiBitboard. Com um ThreadPool as
+ * simulações rodam em paralelo na mesma árvore: a descida e a atualização acontecem sob uma
+ * trava e cada nó visitado recebe uma "perda virtual" até a simulação terminar, afastando as
+ * outras threads do mesmo caminho. Os nós vêm de uma arena de tamanho fixo, reiniciada a cada jogada.
+ *
+ * O orçamento é o número de simulações (LimiteBusca::maxNos) e/ou um prazo. Tabuleiros que não
+ * são 8x8 usam a busca alfa-beta do ReversiBot.
+ */
+class MCTSReversiBot : public ReversiBot {
+public:
+    /**
+     * @param simulacoes Simulações por jogada quando não há outro limite.
+     * @param pool Threads para simulações em paralelo (nullptr = apenas a thread que chama).
+     * @param capacidade Número máximo de nós da árvore.
+     */
+    explicit MCTSReversiBot(int simulacoes = 20000, ThreadPool* pool = nullptr, std::size_t capacidade = 1 << 19);
+
+    std::pair<int, int> calcularProximaJogada(
+        const JogosDeTabuleiro& jogo,
+        int jogadorAtual
+    ) override;
+    std::pair<int, int> calcularProximaJogada(
+        const JogosDeTabuleiro& jogo,
+        int jogadorAtual,
+        const LimiteBusca& limite
+    ) override;
+
+    void setSimulacoes(int simulacoes) { simulacoes_ = simulacoes; }
+    int getSimulacoes() const { return simulacoes_; }
+
+private:
+    int simulacoes_;
+    uint64_t semente_;
+    std::vector<NoMCTS> arena_;  ///< Alocada uma vez; só os primeiros "usados_" nós são válidos
+    std::size_t usados_;
+    std::mutex arvore_;          ///< Protege arena_ e usados_ durante a busca paralela
+
+    int novoNo(const ReversiBitboard& tabuleiro, int casa, int jogador);
+    int melhorFilho(int pai) const;
+    void simular(const ReversiBitboard& raiz, int jogador, const LimiteBusca& limite,
+                 std::atomic<long long>& simulacoes, uint64_t semente, int& profundidade);
+    static int jogarAteOFim(ReversiBitboard tabuleiro, int jogador, uint64_t& aleatorio);
+};
+
+#endif
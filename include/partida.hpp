@@ -9,7 +9,7 @@
 class Partida {
 public:
     // Constructors
-    Partida(int tipoJogo, Jogador* jogador1);  // For PvE
+    Partida(int tipoJogo, Jogador* jogador1, ThreadPool* pool = nullptr);  // For PvE (pool: threads do bot)
     Partida(int tipoJogo, Jogador* jogador1, Jogador* jogador2);  // For PvP
     
     // Destructor to clean up bot pointers
@@ -20,7 +20,7 @@ public:
 
     // Game control methods
     bool iniciarPartida();
-    bool iniciarPartida(int dificuldade);  // For future difficulty levels
+    bool iniciarPartida(int dificuldade);  // 1 (fácil) a 4 (perfeito): ajusta o bot antes de começar
     void imprimirTabuleiro(int jogadorAtual) const;
     bool realizarJogada(int jogadorAtual, int linha = -1, int coluna = -1);
     bool verificarFimDeJogo() const;
@@ -38,6 +38,7 @@ private:
     Jogador* jogador2;
     BotPlayer* bot1;
     BotPlayer* bot2;
+    ThreadPool* pool;  // Threads emprestadas aos bots (não pertencem à partida)
 
     std::pair<int, int> finalizarPartida();
 };
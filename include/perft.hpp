@@ -0,0 +1,53 @@
+#ifndef PERFT_HPP
+#define PERFT_HPP
+
+/**
+ * @file perft.hpp
+ * @brief Contagem de folhas da árvore de jogadas (perft) do Reversi e do Lig4, para medir a geração
+ *        de jogadas e comparar implementações do tabuleiro entre si.
+ *
+ * Convenções: uma posição final antes da profundidade pedida conta como uma folha; no Reversi,
+ * passar a vez (sem jogadas válidas, com o oponente ainda podendo jogar) consome um nível.
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "bitboard.hpp"
+#include "jogos.hpp"
+
+class ThreadPool;
+
+/**
+ * @class Perft
+ * @brief Perft sobre três implementações: a de referência (casa a casa, sem bitboards), o tabuleiro
+ *        normal (JogosDeTabuleiro, com bitboards quando cabem) e as máscaras de bits puras.
+ */
+class Perft {
+public:
+    enum Implementacao { REFERENCIA, TABULEIRO, BITS };
+
+    /// Nome usado na saída da ferramenta ("referencia", "tabuleiro", "bits").
+    static const char* nome(Implementacao implementacao);
+
+    /// Folhas a "profundidade" jogadas do Reversi (8x8 para a implementação BITS) a partir da posição inicial.
+    static long long reversi(Implementacao implementacao, int profundidade, int tamanho = 8);
+    /// Folhas a "profundidade" jogadas do Lig4 (linhas x colunas) a partir do tabuleiro vazio.
+    static long long lig4(Implementacao implementacao, int profundidade, int linhas = 6, int colunas = 7);
+
+    /**
+     * @brief Mesma contagem, dividindo o trabalho pelas jogadas da raiz: cada uma vira uma tarefa do pool.
+     * @param jogo "reversi" ou "lig4".
+     * @throws std::invalid_argument Se o jogo for desconhecido.
+     */
+    static long long paralelo(ThreadPool& pool, const std::string& jogo, Implementacao implementacao,
+                              int profundidade, int linhas, int colunas);
+
+    // Recursões sobre cada implementação, a partir de uma posição qualquer
+    static long long reversi(Reversi& jogo, int jogador, int profundidade);
+    static long long reversi(uint64_t proprias, uint64_t oponente, int profundidade);
+    static long long lig4(Lig4& jogo, int jogador, int profundidade);
+    static long long lig4(Lig4Bitboard& bits, int jogador, int profundidade);
+};
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef SOLUCIONADORLIG4_HPP
+#define SOLUCIONADORLIG4_HPP
+
+/**
+ * @file solucionadorlig4.hpp
+ * @brief Solução exata (jogo perfeito) de posições do Lig4 no tabuleiro padrão 7x6.
+ */
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include "busca.hpp"
+
+/**
+ * @class SolucionadorLig4
+ * @brief Calcula o valor teórico e a melhor jogada de qualquer posição 7x6.
+ *
+ * A posição é um par de bitboards no formato do Lig4Bitboard (7 bits por coluna, de baixo para
+ * cima, com a linha sentinela): as peças do jogador da vez e a máscara das casas ocupadas.
+ * A busca é um negamax com janela nula e busca binária sobre o valor, limites guardados na tabela
+ * de transposição do contexto, descarte das jogadas que entregam a vitória ao oponente e ordenação
+ * pelo número de ameaças criadas (colunas centrais primeiro em caso de empate).
+ *
+ * Valor: 0 é empate; positivo, o jogador da vez vence, e vale mais quanto mais cedo
+ * ((43 - jogadas) / 2 para a vitória na própria jogada); negativo, o oponente vence.
+ *
+ * Uma tabela de abertura opcional (arquivo texto) evita as buscas longas do começo da partida.
+ */
+class SolucionadorLig4 {
+public:
+    static const int LARGURA = 7;
+    static const int ALTURA = 6;
+
+    SolucionadorLig4() : jogadasAbertura_(-1) {}
+
+    /**
+     * @brief Resolve a posição. Não pode haver quatro em linha no tabuleiro.
+     * @param proprias Peças do jogador da vez.
+     * @param mascara Todas as casas ocupadas.
+     * @param contexto Tabela de transposição, contador de nós e limite (prazo/nós) da busca.
+     * @param melhorColuna Recebe a coluna (0 a 6) da melhor jogada, ou -1 se o tabuleiro estiver cheio.
+     * @return O valor teórico da posição (sem significado se a busca foi interrompida).
+     */
+    int resolver(uint64_t proprias, uint64_t mascara, ContextoBusca& contexto, int& melhorColuna) const;
+
+    /**
+     * @brief Lê uma tabela de abertura: uma posição por linha, como a sequência de colunas jogadas
+     *        (1 a 7, "-" para a posição inicial) seguida do valor da posição.
+     * @return false se o arquivo não puder ser aberto.
+     * @throw std::invalid_argument Se alguma linha estiver mal formatada.
+     */
+    bool carregarAbertura(const std::string& caminho);
+
+    /**
+     * @brief Resolve todas as posições com até "jogadas" peças e grava a tabela de abertura; as
+     *        posições resolvidas também passam a valer na tabela deste solucionador.
+     * @param progresso Chamada antes de cada nível (peças, posições do nível), do mais profundo ao 0.
+     * @throw std::runtime_error Se o arquivo não puder ser escrito ou o limite do contexto estourar.
+     */
+    void gravarAbertura(const std::string& caminho, int jogadas, ContextoBusca& contexto,
+                        const std::function<void(int, std::size_t)>& progresso = nullptr);
+
+    std::size_t getTamanhoAbertura() const { return abertura_.size(); }
+
+private:
+    std::unordered_map<uint64_t, int8_t> abertura_;  ///< proprias + mascara -> valor
+    int jogadasAbertura_;                           ///< Maior número de peças das posições da tabela
+
+    int negamax(uint64_t proprias, uint64_t mascara, int alfa, int beta, ContextoBusca& contexto) const;
+    int valor(uint64_t proprias, uint64_t mascara, ContextoBusca& contexto) const;
+};
+
+#endif
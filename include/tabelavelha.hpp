@@ -0,0 +1,96 @@
+#ifndef TABELAVELHA_HPP
+#define TABELAVELHA_HPP
+
+/**
+ * @file tabelavelha.hpp
+ * @brief Tabela de jogadas perfeitas do Jogo da Velha 3x3, calculada pelo compilador (constexpr).
+ */
+
+#include <cstdint>
+
+/**
+ * @struct JogadaVelha
+ * @brief Melhor jogada e valor de uma posição do Jogo da Velha 3x3.
+ */
+struct JogadaVelha {
+    int8_t casa;   ///< Casa (linha * 3 + coluna) da melhor jogada; -1 se o jogo acabou
+    int8_t valor;  ///< Para quem joga: > 0 vence (maior = mais cedo), 0 empata, < 0 perde
+};
+
+/**
+ * @class TabelaVelha
+ * @brief Uma entrada por posição (codificada em base 3) e jogador da vez: 2 x 3^9 entradas.
+ *
+ * A casa i vale 3^i no código e guarda 0 (vazia), 1 ou 2. Colocar uma peça sempre aumenta o
+ * código, então percorrer os códigos do maior para o menor encontra as posições seguintes já
+ * resolvidas: a tabela inteira sai de uma única passada, sem busca em árvore.
+ */
+class TabelaVelha {
+public:
+    static constexpr int CASAS = 9;
+    static constexpr int POSICOES = 19683; // 3^9
+
+    constexpr TabelaVelha() : jogadas_() {
+        int potencias[CASAS] = {1, 3, 9, 27, 81, 243, 729, 2187, 6561};
+        // Desempate: centro, cantos e depois bordas
+        const int ordem[CASAS] = {4, 0, 2, 6, 8, 1, 3, 5, 7};
+
+        for (int codigo = POSICOES - 1; codigo >= 0; codigo--) {
+            int casas[CASAS] = {};
+            int pecas = 0;
+            for (int i = 0, resto = codigo; i < CASAS; i++, resto /= 3) {
+                casas[i] = resto % 3;
+                if (casas[i] != 0) pecas++;
+            }
+            int vencedor = vencedorDe(casas);
+
+            for (int jogador = 1; jogador <= 2; jogador++) {
+                JogadaVelha& entrada = jogadas_[jogador - 1][codigo];
+                entrada.casa = -1;
+                if (vencedor != 0) {
+                    int placar = CASAS + 1 - pecas;
+                    entrada.valor = static_cast<int8_t>(vencedor == jogador ? placar : -placar);
+                    continue;
+                }
+                entrada.valor = 0;
+                int melhor = -100;
+                for (int k = 0; k < CASAS; k++) {
+                    int casa = ordem[k];
+                    if (casas[casa] != 0) continue;
+                    int valor = -jogadas_[2 - jogador][codigo + jogador * potencias[casa]].valor;
+                    if (valor > melhor) {
+                        melhor = valor;
+                        entrada.casa = static_cast<int8_t>(casa);
+                        entrada.valor = static_cast<int8_t>(valor);
+                    }
+                }
+            }
+        }
+    }
+
+    /// Entrada da posição "codigo" com "jogador" (1 ou 2) na vez.
+    constexpr const JogadaVelha& consultar(int codigo, int jogador) const {
+        return jogadas_[jogador - 1][codigo];
+    }
+
+private:
+    JogadaVelha jogadas_[2][POSICOES];
+
+    static constexpr int vencedorDe(const int* casas) {
+        const int linhas[8][3] = {
+            {0, 1, 2}, {3, 4, 5}, {6, 7, 8},
+            {0, 3, 6}, {1, 4, 7}, {2, 5, 8},
+            {0, 4, 8}, {2, 4, 6}
+        };
+        for (int i = 0; i < 8; i++) {
+            int a = casas[linhas[i][0]];
+            if (a != 0 && a == casas[linhas[i][1]] && a == casas[linhas[i][2]]) return a;
+        }
+        return 0;
+    }
+};
+
+/// Tabela gerada uma vez, na compilação de tabelavelha.cpp.
+const TabelaVelha& tabelaVelha();
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+/**
+ * @file threadpool.hpp
+ * @brief Conjunto fixo de threads que executam tarefas de uma fila compartilhada.
+ */
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief Threads criadas uma única vez e reaproveitadas entre tarefas (por exemplo, a cada jogada do bot).
+ *
+ * Quem cria o pool é dono dele; os bots apenas recebem um ponteiro. O destrutor espera as
+ * tarefas já enviadas terminarem.
+ */
+class ThreadPool {
+public:
+    /// @param threads Número de threads de trabalho (mínimo 1).
+    explicit ThreadPool(int threads);
+    ~ThreadPool();
+
+    /**
+     * @brief Coloca uma tarefa na fila.
+     * @return Futuro que fica pronto quando a tarefa termina (e repassa exceções lançadas por ela).
+     */
+    template <class Tarefa>
+    std::future<void> enviar(Tarefa tarefa) {
+        auto pacote = std::make_shared<std::packaged_task<void()>>(std::move(tarefa));
+        std::future<void> futuro = pacote->get_future();
+        {
+            std::lock_guard<std::mutex> trava(mutex_);
+            fila_.push([pacote]() { (*pacote)(); });
+        }
+        condicao_.notify_one();
+        return futuro;
+    }
+
+    int getThreads() const { return static_cast<int>(threads_.size()); }
+
+    /// Número de núcleos da máquina (1 se não puder ser determinado).
+    static int nucleosDisponiveis();
+
+private:
+    std::vector<std::thread> threads_;
+    std::queue<std::function<void()>> fila_;
+    std::mutex mutex_;
+    std::condition_variable condicao_;
+    bool encerrando_;
+
+    void trabalhar();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+};
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef TRANSPOSICAO_HPP
+#define TRANSPOSICAO_HPP
+
+/**
+ * @file transposicao.hpp
+ * @brief Tabela de transposição usada pelas buscas dos bots para reaproveitar posições já avaliadas.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct EntradaTT
+ * @brief Resultado guardado de uma posição, como lido da tabela.
+ */
+struct EntradaTT {
+    enum Tipo : uint8_t { VAZIA = 0, EXATA = 1, INFERIOR = 2, SUPERIOR = 3 };
+
+    uint64_t chave;        ///< Hash Zobrist completo da posição (inclui o jogador da vez)
+    int32_t pontuacao;
+    int8_t profundidade;
+    uint8_t tipo_geracao;  ///< 2 bits de Tipo e 6 bits da geração (busca) que gravou a entrada
+    int8_t linha;          ///< Melhor jogada encontrada (-1 se nenhuma)
+    int8_t coluna;
+
+    Tipo tipo() const { return static_cast<Tipo>(tipo_geracao & 3); }
+    int geracao() const { return tipo_geracao >> 2; }
+};
+
+/**
+ * @class TabelaTransposicao
+ * @brief Tabela de tamanho fixo (em MB) organizada em baldes de 64 bytes alinhados à linha de cache.
+ *
+ * Cada chave indexa um balde de quatro entradas. Uma consulta lê uma única linha de cache; na
+ * gravação, a entrada substituída é a da mesma posição ou, na falta dela, a mais antiga e rasa.
+ *
+ * Pode ser compartilhada por várias threads sem travas: cada entrada são duas palavras atômicas
+ * (chave ^ dados, dados). Uma entrada corrompida por escritas simultâneas não confere com a chave
+ * e é simplesmente ignorada na consulta.
+ */
+class TabelaTransposicao {
+public:
+    explicit TabelaTransposicao(std::size_t megabytes = 8);
+
+    /// Altera o tamanho da tabela, descartando o conteúdo.
+    void redimensionar(std::size_t megabytes);
+    void limpar();
+    /// Marca o início de uma nova busca; entradas de buscas anteriores passam a ser substituídas primeiro.
+    void nova_busca() { geracao_.store((geracao_.load() + 1) & 63); }
+
+    bool consultar(uint64_t chave, EntradaTT& entrada) const;
+    void guardar(uint64_t chave, int profundidade, int pontuacao, EntradaTT::Tipo tipo, int linha, int coluna);
+
+    std::size_t getMegabytes() const { return megabytes_; }
+    std::size_t getEntradas() const { return total_baldes_ * ENTRADAS_POR_BALDE; }
+
+private:
+    static const int ENTRADAS_POR_BALDE = 4;
+
+    struct Espaco {
+        std::atomic<uint64_t> verificacao;  ///< chave ^ dados
+        std::atomic<uint64_t> dados;        ///< Pontuação, profundidade, tipo/geração e jogada empacotados
+    };
+
+    struct alignas(64) Balde {
+        Espaco entradas[ENTRADAS_POR_BALDE];
+    };
+
+    static uint64_t empacotar(const EntradaTT& entrada);
+    static EntradaTT desempacotar(uint64_t chave, uint64_t dados);
+
+    std::vector<unsigned char> memoria_;  ///< Área bruta; baldes_ aponta para seu primeiro endereço alinhado
+    Balde* baldes_;
+    std::size_t total_baldes_;            ///< Sempre potência de dois
+    std::size_t megabytes_;
+    std::atomic<int> geracao_;
+
+    // Uma tabela ocupa vários megabytes: não deve ser copiada por engano
+    TabelaTransposicao(const TabelaTransposicao&) = delete;
+    TabelaTransposicao& operator=(const TabelaTransposicao&) = delete;
+
+    Balde& balde(uint64_t chave) const { return baldes_[chave & (total_baldes_ - 1)]; }
+};
+
+#endif
@@ -0,0 +1,257 @@
+/**
+ * @file arena.cpp
+ * @brief Declaração dos métodos da classe Arena.
+ */
+
+#include "arena.hpp"
+#include "mcts.hpp"
+#include "threadpool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+/// Diferença de Elo correspondente a uma pontuação esperada entre 0 e 1 (exclusive).
+double eloDaPontuacao(double pontuacao) {
+    return -400.0 * std::log10(1.0 / pontuacao - 1.0);
+}
+
+/// Jogadas válidas do jogador; no Lig4 basta a coluna.
+std::vector<std::pair<int, int>> jogadasValidas(const JogosDeTabuleiro& jogo, int jogador) {
+    std::vector<std::pair<int, int>> jogadas;
+    if (dynamic_cast<const Lig4*>(&jogo)) {
+        for (int coluna = 0; coluna < jogo.getColunas(); coluna++) {
+            if (jogo.verificar_jogada(0, coluna, jogador)) jogadas.push_back({0, coluna});
+        }
+        return jogadas;
+    }
+    for (int linha = 0; linha < jogo.getLinhas(); linha++) {
+        for (int coluna = 0; coluna < jogo.getColunas(); coluna++) {
+            if (jogo.verificar_jogada(linha, coluna, jogador)) jogadas.push_back({linha, coluna});
+        }
+    }
+    return jogadas;
+}
+
+/// Vencedor de uma partida terminada (1, 2 ou 0 para empate), sem o placar impresso pelo Reversi.
+int vencedorFinal(const JogosDeTabuleiro& jogo) {
+    if (const Reversi* reversi = dynamic_cast<const Reversi*>(&jogo)) {
+        std::pair<int, int> pontos = reversi->calcular_pontuacao();
+        return pontos.first > pontos.second ? 1 : (pontos.second > pontos.first ? 2 : 0);
+    }
+    return jogo.determinar_vencedor();
+}
+
+/// Orçamentos de nós das soluções exatas (no lugar dos prazos, que dependem da carga da máquina);
+/// com -O2, ficam perto dos prazos padrão dos bots (1 s no Reversi e 3 s no Lig4).
+const long long NOS_SOLUCAO_REVERSI = 10000000;
+const long long NOS_SOLUCAO_LIG4 = 30000000;
+
+} // namespace
+
+// --- Configuração e resultado ---
+
+ConfiguracaoBot ConfiguracaoBot::ler(const std::string& texto) {
+    ConfiguracaoBot bot{texto, 0};
+    std::size_t separador = texto.find(':');
+    if (separador != std::string::npos) {
+        bot.tipo = texto.substr(0, separador);
+        std::string nivel = texto.substr(separador + 1);
+        if (nivel.empty() || nivel.size() > 9 || nivel.find_first_not_of("0123456789") != std::string::npos) {
+            throw std::invalid_argument("Nível inválido para o bot: " + texto);
+        }
+        bot.nivel = std::stoi(nivel);
+    }
+    if (bot.tipo != "alfabeta" && bot.tipo != "mcts" && bot.tipo != "perfeito") {
+        throw std::invalid_argument("Bot desconhecido (use alfabeta, mcts ou perfeito): " + texto);
+    }
+    return bot;
+}
+
+double ResultadoArena::pontuacao() const {
+    return partidas() > 0 ? (vitorias + 0.5 * empates) / partidas() : 0.5;
+}
+
+double ResultadoArena::elo() const {
+    if (partidas() == 0) return 0.0;
+    // Placar de 100% ou 0% teria Elo infinito: conta meia partida a menos para o lado que venceu tudo
+    double meia = 0.5 / partidas();
+    return eloDaPontuacao(std::min(std::max(pontuacao(), meia), 1.0 - meia));
+}
+
+double ResultadoArena::erroElo() const {
+    int n = partidas();
+    if (n < 2) return 0.0;
+    double media = pontuacao();
+    double variancia = (vitorias * (1.0 - media) * (1.0 - media) + empates * (0.5 - media) * (0.5 - media) +
+                        derrotas * media * media) / n;
+    double desvio = std::sqrt(variancia / n);
+    double meia = 0.5 / n;
+    double minimo = std::min(std::max(media - 1.96 * desvio, meia), 1.0 - meia);
+    double maximo = std::min(std::max(media + 1.96 * desvio, meia), 1.0 - meia);
+    return (eloDaPontuacao(maximo) - eloDaPontuacao(minimo)) / 2.0;
+}
+
+// --- Arena ---
+
+Arena::Arena(const ConfiguracaoArena& configuracao) : configuracao_(configuracao) {
+    if (configuracao_.tipoJogo < 1 || configuracao_.tipoJogo > 3) {
+        throw std::invalid_argument("Jogo inválido para a arena (use 1, 2 ou 3)");
+    }
+    if (configuracao_.partidas < 0 || configuracao_.threads < 1 || configuracao_.aberturaAleatoria < 0) {
+        throw std::invalid_argument("Número de partidas, threads ou jogadas de abertura inválido");
+    }
+    if (configuracao_.tipoJogo == 3 && configuracao_.colunas > 0 && configuracao_.colunas != configuracao_.linhas) {
+        throw std::invalid_argument("O Reversi só é jogado em tabuleiros quadrados");
+    }
+    for (const ConfiguracaoBot& bot : configuracao_.bots) criarBot(configuracao_.tipoJogo, bot);
+    criarJogo(); // Valida o tamanho do tabuleiro (e o k) antes de começar
+}
+
+std::unique_ptr<BotPlayer> Arena::criarBot(int tipoJogo, const ConfiguracaoBot& bot) {
+    if (bot.nivel < 0) throw std::invalid_argument("Nível negativo para o bot: " + bot.tipo);
+    if (bot.tipo == "mcts") {
+        if (tipoJogo != 3) throw std::invalid_argument("O bot mcts é só para o Reversi");
+        MCTSReversiBot* mcts = bot.nivel > 0 ? new MCTSReversiBot(bot.nivel) : new MCTSReversiBot();
+        mcts->setNosFinal(NOS_SOLUCAO_REVERSI);
+        return std::unique_ptr<BotPlayer>(mcts);
+    }
+    if (bot.tipo == "perfeito" && tipoJogo == 3) {
+        throw std::invalid_argument("Não há bot perfeito para o Reversi");
+    }
+    if (bot.tipo != "alfabeta" && bot.tipo != "perfeito") {
+        throw std::invalid_argument("Bot desconhecido: " + bot.tipo);
+    }
+
+    switch (tipoJogo) {
+        case 1:
+            // No 3x3 o JogoDaVelhaBot já é perfeito (tabela completa); o nível vale para tabuleiros maiores
+            return std::unique_ptr<BotPlayer>(bot.nivel > 0 ? new JogoDaVelhaBot(bot.nivel) : new JogoDaVelhaBot());
+        case 2: {
+            Lig4Bot* lig4 = bot.nivel > 0 ? new Lig4Bot(bot.nivel) : new Lig4Bot();
+            if (bot.tipo == "perfeito") {
+                lig4->setModoPerfeito(true);
+                lig4->setNosPerfeito(NOS_SOLUCAO_LIG4);
+                lig4->carregarAbertura("abertura_lig4.txt"); // Opcional, como na Partida
+            }
+            return std::unique_ptr<BotPlayer>(lig4);
+        }
+        default: {
+            ReversiBot* reversi = bot.nivel > 0 ? new ReversiBot(bot.nivel) : new ReversiBot();
+            reversi->setNosFinal(NOS_SOLUCAO_REVERSI);
+            return std::unique_ptr<BotPlayer>(reversi);
+        }
+    }
+}
+
+std::unique_ptr<JogosDeTabuleiro> Arena::criarJogo() const {
+    int linhas = configuracao_.linhas, colunas = configuracao_.colunas;
+    switch (configuracao_.tipoJogo) {
+        case 1:
+            return std::unique_ptr<JogosDeTabuleiro>(
+                new JogoDaVelha(linhas > 0 ? linhas : 3, colunas > 0 ? colunas : 3, configuracao_.k));
+        case 2:
+            return std::unique_ptr<JogosDeTabuleiro>(new Lig4(linhas > 0 ? linhas : 6, colunas > 0 ? colunas : 7));
+        default:
+            return std::unique_ptr<JogosDeTabuleiro>(new Reversi(linhas > 0 ? linhas : 8, linhas > 0 ? linhas : 8));
+    }
+}
+
+int Arena::sortearAbertura(JogosDeTabuleiro& jogo, int par) const {
+    std::mt19937 gerador(configuracao_.semente * 0x9e3779b9u + static_cast<unsigned>(par));
+    Reversi* reversi = dynamic_cast<Reversi*>(&jogo);
+    int jogador = 1;
+    RegistroJogada registro;
+
+    for (int i = 0; i < configuracao_.aberturaAleatoria; i++) {
+        if (reversi && !reversi->tem_jogadas(jogador)) jogador = (jogador == 1) ? 2 : 1;
+        std::vector<std::pair<int, int>> jogadas = jogadasValidas(jogo, jogador);
+        std::shuffle(jogadas.begin(), jogadas.end(), gerador);
+
+        bool jogou = false;
+        for (const std::pair<int, int>& jogada : jogadas) {
+            if (!jogo.fazer_jogada(jogada.first, jogada.second, jogador, registro)) continue;
+            if (!jogo.testar_condicao_de_vitoria()) {
+                jogou = true;
+                break;
+            }
+            jogo.desfazer_jogada(registro);
+        }
+        if (!jogou) break; // Toda jogada terminaria a partida: a abertura fica mais curta
+        jogador = (jogador == 1) ? 2 : 1;
+    }
+    return jogador;
+}
+
+int Arena::jogar(JogosDeTabuleiro& jogo, BotPlayer* bots[2], int jogador) {
+    Reversi* reversi = dynamic_cast<Reversi*>(&jogo);
+    RegistroJogada registro;
+
+    while (!jogo.testar_condicao_de_vitoria()) {
+        int oponente = (jogador == 1) ? 2 : 1;
+        if (reversi && !reversi->tem_jogadas(jogador)) {
+            jogador = oponente; // Passa a vez
+            continue;
+        }
+        std::pair<int, int> jogada = bots[jogador - 1]->calcularProximaJogada(jogo, jogador);
+        if (!jogo.verificar_jogada(jogada.first, jogada.second, jogador) ||
+            !jogo.fazer_jogada(jogada.first, jogada.second, jogador, registro)) {
+            return oponente;
+        }
+        jogador = oponente;
+    }
+    return vencedorFinal(jogo);
+}
+
+ResultadoArena Arena::executar() {
+    typedef std::chrono::steady_clock Relogio;
+    Relogio::time_point inicio = Relogio::now();
+    std::atomic<int> proxima(0), vitorias(0), empates(0), derrotas(0);
+
+    auto trabalhar = [this, &proxima, &vitorias, &empates, &derrotas]() {
+        for (int partida = proxima++; partida < configuracao_.partidas; partida = proxima++) {
+            // Partidas pares: A com as peças 1; ímpares: mesma abertura com os lados trocados
+            bool trocados = (partida % 2) == 1;
+            std::unique_ptr<BotPlayer> botA = criarBot(configuracao_.tipoJogo, configuracao_.bots[0]);
+            std::unique_ptr<BotPlayer> botB = criarBot(configuracao_.tipoJogo, configuracao_.bots[1]);
+            BotPlayer* bots[2] = {botA.get(), botB.get()};
+            if (trocados) std::swap(bots[0], bots[1]);
+
+            std::unique_ptr<JogosDeTabuleiro> jogo = criarJogo();
+            int jogador = sortearAbertura(*jogo, partida / 2);
+            int vencedor = jogar(*jogo, bots, jogador);
+
+            int pecasA = trocados ? 2 : 1;
+            if (vencedor == 0) {
+                empates++;
+            } else if (vencedor == pecasA) {
+                vitorias++;
+            } else {
+                derrotas++;
+            }
+        }
+    };
+
+    if (configuracao_.threads == 1) {
+        trabalhar();
+    } else {
+        ThreadPool pool(configuracao_.threads);
+        std::vector<std::future<void>> futuros;
+        for (int i = 0; i < configuracao_.threads; i++) futuros.push_back(pool.enviar(trabalhar));
+        for (std::future<void>& futuro : futuros) futuro.wait();
+        for (std::future<void>& futuro : futuros) futuro.get();
+    }
+
+    ResultadoArena resultado;
+    resultado.vitorias = vitorias;
+    resultado.empates = empates;
+    resultado.derrotas = derrotas;
+    resultado.segundos = std::chrono::duration<double>(Relogio::now() - inicio).count();
+    return resultado;
+}
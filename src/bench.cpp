@@ -0,0 +1,415 @@
+/**
+ * @file bench.cpp
+ * @brief Medições de desempenho (alvo "make bench"): geração de jogadas, detecção de fim de jogo,
+ *        buscas dos bots e persistência do cadastro.
+ *
+ * Cada linha da saída é um objeto JSON independente, identificado pelo campo "id", com o tempo por
+ * operação (ns_por_op), nós por segundo (buscas) e alocações por operação. Com "--base arquivo",
+ * cada medição é comparada com a linha de mesmo "id" de uma execução anterior guardada no arquivo.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+#include "botplayer.hpp"
+#include "cadastro.hpp"
+#include "jogos.hpp"
+#include "mcts.hpp"
+#include "threadpool.hpp"
+
+// --- Contagem de alocações: todo operator new do programa passa por aqui ---
+
+namespace {
+std::atomic<long long> alocacoes(0);
+}
+
+void* operator new(std::size_t tamanho) {
+    alocacoes.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(tamanho ? tamanho : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t tamanho) { return operator new(tamanho); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+typedef std::chrono::steady_clock Relogio;
+
+/// Tolerância antes de uma medição ser marcada como regressão em relação à base (ruído de medição).
+const double TOLERANCIA = 1.25;
+
+/**
+ * @struct Medicao
+ * @brief Resultado de um benchmark: "operacoes" repetições que visitaram "nos" posições (0 se não se aplica).
+ */
+struct Medicao {
+    std::string id;
+    long long operacoes;
+    double nanossegundos;
+    long long nos;
+    long long alocacoes;
+};
+
+std::map<std::string, double> base;  ///< ns_por_op de cada "id" da execução de referência
+int comparadas = 0;
+int regressoes = 0;
+
+/**
+ * @brief Lê um arquivo de saída anterior do bench; linhas sem "id" ou "ns_por_op" são ignoradas.
+ */
+void carregarBase(const std::string& caminho) {
+    std::ifstream arquivo(caminho);
+    std::string linha;
+    while (std::getline(arquivo, linha)) {
+        std::size_t id = linha.find("\"id\":\"");
+        std::size_t ns = linha.find("\"ns_por_op\":");
+        if (id == std::string::npos || ns == std::string::npos) continue;
+        id += 6;
+        base[linha.substr(id, linha.find('"', id) - id)] = std::atof(linha.c_str() + ns + 12);
+    }
+}
+
+void relatar(const Medicao& m) {
+    double nsPorOp = m.nanossegundos / m.operacoes;
+    std::printf("{\"id\":\"%s\",\"ops\":%lld,\"ns_por_op\":%.1f", m.id.c_str(), m.operacoes, nsPorOp);
+    if (m.nos > 0) {
+        std::printf(",\"nos\":%lld,\"nos_por_s\":%.0f", m.nos, m.nos / (m.nanossegundos / 1e9));
+    }
+    std::printf(",\"alocacoes_por_op\":%.2f", static_cast<double>(m.alocacoes) / m.operacoes);
+
+    std::map<std::string, double>::const_iterator referencia = base.find(m.id);
+    if (referencia != base.end() && referencia->second > 0) {
+        double razao = nsPorOp / referencia->second;
+        bool regrediu = razao > TOLERANCIA;
+        comparadas++;
+        if (regrediu) regressoes++;
+        std::printf(",\"base_ns_por_op\":%.1f,\"razao\":%.2f,\"regressao\":%s",
+                    referencia->second, razao, regrediu ? "true" : "false");
+    }
+    std::printf("}\n");
+    std::fflush(stdout);
+}
+
+/**
+ * @brief Mede "corpo" (que retorna os nós visitados, ou 0) e conta as alocações feitas durante a medição.
+ */
+template <class Corpo>
+Medicao medir(const std::string& id, long long operacoes, Corpo corpo) {
+    Medicao m;
+    m.id = id;
+    m.operacoes = operacoes;
+    long long alocacoesAntes = alocacoes.load();
+    Relogio::time_point inicio = Relogio::now();
+    m.nos = corpo();
+    m.nanossegundos = std::chrono::duration<double, std::nano>(Relogio::now() - inicio).count();
+    m.alocacoes = alocacoes.load() - alocacoesAntes;
+    return m;
+}
+
+/// Descarta o que for escrito: Cadastro::import/save anunciam o sucesso em std::cout.
+class BufferNulo : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+// --- Corpus de posições (sementes fixas: toda execução mede as mesmas posições) ---
+
+/**
+ * @brief Gera uma posição de meio de jogo de Reversi com jogadas aleatórias (semente fixa).
+ * @param jogadas Número de jogadas a partir da posição inicial.
+ * @param semente Semente do gerador.
+ * @param jogador Recebe o jogador da vez na posição gerada.
+ */
+Reversi posicaoReversi(int jogadas, unsigned semente, int& jogador, int tamanho = 8) {
+    Reversi jogo(tamanho, tamanho);
+    std::mt19937 gerador(semente);
+    jogador = 1;
+    for (int n = 0; n < jogadas && !jogo.testar_condicao_de_vitoria(); n++) {
+        std::vector<std::pair<int, int>> validas;
+        for (int linha = 0; linha < jogo.getLinhas(); linha++) {
+            for (int coluna = 0; coluna < jogo.getColunas(); coluna++) {
+                if (jogo.verificar_jogada(linha, coluna, jogador)) validas.push_back(std::make_pair(linha, coluna));
+            }
+        }
+        if (!validas.empty()) {
+            std::pair<int, int> jogada = validas[gerador() % validas.size()];
+            jogo.ler_jogada(jogada.first, jogada.second, jogador);
+        }
+        jogador = (jogador == 1) ? 2 : 1;
+    }
+    return jogo;
+}
+
+/**
+ * @brief Gera uma posição de Lig4 sem vencedor com até "jogadas" peças (semente fixa).
+ */
+Lig4 posicaoLig4(int linhas, int colunas, int jogadas, unsigned semente, int& jogador) {
+    Lig4 jogo(linhas, colunas);
+    std::mt19937 gerador(semente);
+    jogador = 1;
+    RegistroJogada registro;
+    for (int n = 0; n < jogadas; n++) {
+        int coluna = gerador() % colunas;
+        if (!jogo.fazer_jogada(0, coluna, jogador, registro)) continue;
+        if (jogo.testar_condicao_de_vitoria()) {
+            jogo.desfazer_jogada(registro); // Mantém a posição em andamento
+            continue;
+        }
+        jogador = (jogador == 1) ? 2 : 1;
+    }
+    return jogo;
+}
+
+// --- Geração de jogadas e fim de jogo ---
+
+void benchReversiJogadas() {
+    for (int tamanho : {8, 10}) {
+        std::vector<Reversi> corpus;
+        for (int i = 0; i < 8; i++) {
+            int jogador;
+            corpus.push_back(posicaoReversi(8 + 6 * i, 100 + i, jogador, tamanho));
+        }
+        const int REPETICOES = tamanho == 8 ? 2000 : 200;
+        long long validas = 0;
+        Medicao m = medir("reversi_verificar_jogada/" + std::to_string(tamanho), 0, [&]() -> long long {
+            for (int r = 0; r < REPETICOES; r++) {
+                for (const Reversi& jogo : corpus) {
+                    for (int linha = 0; linha < tamanho; linha++) {
+                        for (int coluna = 0; coluna < tamanho; coluna++) {
+                            validas += jogo.verificar_jogada(linha, coluna, 1 + (linha + r) % 2);
+                        }
+                    }
+                }
+            }
+            return 0;
+        });
+        m.operacoes = static_cast<long long>(REPETICOES) * corpus.size() * tamanho * tamanho;
+        relatar(m);
+
+        // Partidas completas com ler_jogada, sempre na primeira jogada válida
+        const int PARTIDAS = tamanho == 8 ? 200 : 20;
+        long long jogadas = 0;
+        m = medir("reversi_ler_jogada/" + std::to_string(tamanho), 0, [&]() -> long long {
+            for (int p = 0; p < PARTIDAS; p++) {
+                Reversi jogo(tamanho, tamanho);
+                int jogador = 1;
+                while (!jogo.testar_condicao_de_vitoria()) {
+                    bool jogou = false;
+                    for (int casa = (p * 7) % (tamanho * tamanho), k = 0; k < tamanho * tamanho && !jogou; k++) {
+                        int c = (casa + k) % (tamanho * tamanho);
+                        if (jogo.verificar_jogada(c / tamanho, c % tamanho, jogador)) {
+                            jogo.ler_jogada(c / tamanho, c % tamanho, jogador);
+                            jogou = true;
+                            jogadas++;
+                        }
+                    }
+                    jogador = (jogador == 1) ? 2 : 1;
+                }
+            }
+            return 0;
+        });
+        m.operacoes = jogadas;
+        relatar(m);
+    }
+}
+
+void benchLig4Vencedor() {
+    const int tamanhos[2][2] = {{6, 7}, {9, 12}};
+    for (const auto& t : tamanhos) {
+        std::vector<Lig4> corpus;
+        for (int i = 0; i < 8; i++) {
+            int jogador;
+            corpus.push_back(posicaoLig4(t[0], t[1], 6 + 4 * i, 200 + i, jogador));
+        }
+        const int REPETICOES = 20000;
+        long long vencedores = 0;
+        Medicao m = medir("lig4_determinar_vencedor/" + std::to_string(t[0]) + "x" + std::to_string(t[1]), 0,
+                          [&]() -> long long {
+            for (int r = 0; r < REPETICOES; r++) {
+                for (const Lig4& jogo : corpus) vencedores += jogo.determinar_vencedor();
+            }
+            return 0;
+        });
+        m.operacoes = static_cast<long long>(REPETICOES) * corpus.size();
+        relatar(m);
+    }
+}
+
+// --- Bots ---
+
+/**
+ * @brief Mede calcularProximaJogada de um bot em cada posição do corpus.
+ */
+template <class Jogo>
+void medirBot(const std::string& id, BotPlayer& bot, const std::vector<std::pair<Jogo, int>>& corpus) {
+    Medicao m = medir(id, corpus.size(), [&]() -> long long {
+        long long nos = 0;
+        for (const auto& posicao : corpus) {
+            bot.calcularProximaJogada(posicao.first, posicao.second);
+            nos += bot.getNosVisitados();
+        }
+        return nos;
+    });
+    relatar(m);
+}
+
+void benchBots() {
+    std::vector<std::pair<Reversi, int>> reversi;
+    for (int i = 0; i < 4; i++) {
+        int jogador;
+        Reversi jogo = posicaoReversi(12 + 8 * i, 1234 + i, jogador);
+        reversi.push_back(std::make_pair(jogo, jogador));
+    }
+    ReversiBot reversiBot(5);
+    medirBot("bot_reversi/profundidade5", reversiBot, reversi);
+    MCTSReversiBot mcts(3000);
+    medirBot("bot_reversi_mcts/3000", mcts, reversi);
+
+    std::vector<std::pair<Lig4, int>> lig4;
+    for (int i = 0; i < 4; i++) {
+        int jogador;
+        Lig4 jogo = posicaoLig4(6, 7, 4 + 4 * i, 300 + i, jogador);
+        lig4.push_back(std::make_pair(jogo, jogador));
+    }
+    Lig4Bot lig4Bot(8);
+    medirBot("bot_lig4/profundidade8", lig4Bot, lig4);
+
+    std::vector<std::pair<JogoDaVelha, int>> velha;
+    std::vector<std::pair<JogoDaVelha, int>> gomoku;
+    for (int i = 0; i < 4; i++) {
+        JogoDaVelha pequeno(3, 3);
+        JogoDaVelha grande(15, 15, 5);
+        std::mt19937 gerador(400 + i);
+        for (int n = 0; n < i; n++) pequeno.ler_jogada(gerador() % 3, gerador() % 3, 1 + n % 2);
+        for (int n = 0; n < 6 + 2 * i; n++) grande.ler_jogada(5 + gerador() % 5, 5 + gerador() % 5, 1 + n % 2);
+        velha.push_back(std::make_pair(pequeno, 1));
+        gomoku.push_back(std::make_pair(grande, 1));
+    }
+    JogoDaVelhaBot velhaBot;
+    medirBot("bot_velha/3x3", velhaBot, velha);
+    JogoDaVelhaBot gomokuBot(3);
+    medirBot("bot_velha/15x15k5_profundidade3", gomokuBot, gomoku);
+}
+
+/**
+ * @brief Tempo até a profundidade fixa da busca do ReversiBot com 1, 2, 4, ... threads.
+ */
+void benchReversiParalelo(ThreadPool& pool) {
+    const int PROFUNDIDADE = 7;
+    const int POSICOES = 4;
+    double tempoSequencial = 0.0;
+
+    for (int threads = 1; threads <= pool.getThreads() + 1; threads *= 2) {
+        Medicao m = medir("reversi_busca_paralela/" + std::to_string(threads), POSICOES, [&]() -> long long {
+            long long nos = 0;
+            for (int i = 0; i < POSICOES; i++) {
+                int jogador;
+                Reversi jogo = posicaoReversi(12 + 4 * i, 1234 + i, jogador);
+                ReversiBot bot(PROFUNDIDADE, &pool);
+                bot.setThreads(threads);
+                bot.calcularProximaJogada(jogo, jogador);
+                nos += bot.getNosVisitados();
+            }
+            return nos;
+        });
+        if (threads == 1) tempoSequencial = m.nanossegundos;
+        relatar(m);
+        std::printf("{\"id\":\"reversi_aceleracao/%d\",\"aceleracao\":%.2f}\n", threads, tempoSequencial / m.nanossegundos);
+    }
+}
+
+// --- Cadastro ---
+
+void benchCadastro(int maximo, ThreadPool& pool) {
+    const std::string caminho = "bench_cadastro.tmp";
+    BufferNulo nulo;
+
+    for (int jogadores = 1000; jogadores <= maximo; jogadores *= 10) {
+        {
+            std::ofstream arquivo(caminho);
+            std::mt19937 gerador(jogadores);
+            for (int i = 0; i < jogadores; i++) {
+                Jogador jogador("Jogador " + std::to_string(i), "apelido" + std::to_string(i),
+                                gerador() % 100, gerador() % 100, gerador() % 100,
+                                gerador() % 100, gerador() % 100, gerador() % 100);
+                arquivo << jogador.serializar() << "\n";
+            }
+        }
+
+        Cadastro cadastro;
+        std::streambuf* saida = std::cout.rdbuf(&nulo);
+        Medicao importar = medir("cadastro_import/" + std::to_string(jogadores), jogadores, [&]() -> long long {
+            cadastro.import(caminho);
+            return 0;
+        });
+        Medicao importarParalelo = medir("cadastro_import_paralelo/" + std::to_string(jogadores), jogadores, [&]() -> long long {
+            cadastro.import(caminho, pool);
+            return 0;
+        });
+        const std::string binario = caminho + ".bin";
+        cadastro.saveBinario(binario);
+        Medicao importarBinario = medir("cadastro_import_binario/" + std::to_string(jogadores), jogadores, [&]() -> long long {
+            cadastro.importBinario(binario);
+            return 0;
+        });
+        std::remove(binario.c_str());
+        Medicao salvar = medir("cadastro_save/" + std::to_string(jogadores), jogadores, [&]() -> long long {
+            cadastro.save(caminho);
+            return 0;
+        });
+        std::cout.rdbuf(saida);
+        relatar(importar);
+        relatar(importarParalelo);
+        relatar(importarBinario);
+        relatar(salvar);
+    }
+    std::remove(caminho.c_str());
+}
+
+} // namespace
+
+/**
+ * @brief Uso: bench [threads] [--base arquivo] [--jogadores N].
+ *        threads: núcleos da busca paralela (padrão: todos); --base: execução anterior para comparar;
+ *        --jogadores: maior cadastro medido (padrão 1000000).
+ *        Com --base, a última linha resume quantas medições regrediram além da tolerância.
+ */
+int main(int argc, char* argv[]) {
+    int threads = ThreadPool::nucleosDisponiveis();
+    int maximoJogadores = 1000000;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--base") == 0 && i + 1 < argc) {
+            carregarBase(argv[++i]);
+        } else if (std::strcmp(argv[i], "--jogadores") == 0 && i + 1 < argc) {
+            maximoJogadores = std::atoi(argv[++i]);
+        } else {
+            threads = std::atoi(argv[i]);
+        }
+    }
+
+    benchReversiJogadas();
+    benchLig4Vencedor();
+    benchBots();
+    {
+        ThreadPool pool(threads - 1);
+        benchReversiParalelo(pool);
+        benchCadastro(maximoJogadores, pool);
+    }
+
+    if (!base.empty()) {
+        std::printf("{\"id\":\"resumo\",\"comparadas\":%d,\"regressoes\":%d}\n", comparadas, regressoes);
+    }
+    return 0;
+}
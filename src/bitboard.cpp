@@ -0,0 +1,135 @@
+/**
+ * @file bitboard.cpp
+ * @brief Declaração dos métodos das representações em bitboard.
+ */
+
+#include "bitboard.hpp"
+
+namespace {
+
+const uint64_t NAO_COLUNA_A = 0xfefefefefefefefeULL; // Remove a coluna 0 (evita "dar a volta" para a direita)
+const uint64_t NAO_COLUNA_H = 0x7f7f7f7f7f7f7f7fULL; // Remove a coluna 7 (evita "dar a volta" para a esquerda)
+
+/**
+ * @brief Uma das 8 direções: deslocamento em bits e máscara aplicada após o deslocamento.
+ */
+struct Direcao {
+    int deslocamento;
+    uint64_t mascara;
+};
+
+const Direcao DIRECOES[8] = {
+    {-9, NAO_COLUNA_H}, {-8, ~0ULL}, {-7, NAO_COLUNA_A},
+    {-1, NAO_COLUNA_H},              { 1, NAO_COLUNA_A},
+    { 7, NAO_COLUNA_H}, { 8, ~0ULL}, { 9, NAO_COLUNA_A}
+};
+
+inline uint64_t desloca(uint64_t b, int s) {
+    return s > 0 ? (b << s) : (b >> -s);
+}
+
+/**
+ * @brief Preenchimento Kogge-Stone: propaga "gerador" através das casas de "propagador" na direção dada.
+ * @return O gerador acrescido de todas as casas alcançadas em sequência contígua.
+ */
+inline uint64_t preencher(uint64_t gerador, uint64_t propagador, const Direcao& d) {
+    propagador &= d.mascara;
+    gerador |= propagador & desloca(gerador, d.deslocamento);
+    propagador &= desloca(propagador, d.deslocamento);
+    gerador |= propagador & desloca(gerador, 2 * d.deslocamento);
+    propagador &= desloca(propagador, 2 * d.deslocamento);
+    gerador |= propagador & desloca(gerador, 4 * d.deslocamento);
+    return gerador;
+}
+
+} // namespace
+
+int ReversiBitboard::get_casa(int indice) const {
+    uint64_t b = 1ULL << indice;
+    if (pecas_[0] & b) return 1;
+    if (pecas_[1] & b) return 2;
+    return 0;
+}
+
+uint64_t ReversiBitboard::jogadas_validas(uint64_t proprias, uint64_t oponente) {
+    uint64_t livres = ~(proprias | oponente);
+    uint64_t jogadas = 0;
+
+    for (const Direcao& d : DIRECOES) {
+        // Peças do oponente alcançáveis a partir das próprias peças nesta direção
+        uint64_t alcancadas = preencher(proprias, oponente, d) & oponente;
+        jogadas |= desloca(alcancadas, d.deslocamento) & d.mascara & livres;
+    }
+    return jogadas;
+}
+
+uint64_t ReversiBitboard::calcular_viradas(int indice, uint64_t proprias, uint64_t oponente) {
+    uint64_t jogada = 1ULL << indice;
+    if ((proprias | oponente) & jogada) return 0;
+
+    uint64_t viradas = 0;
+
+    for (const Direcao& d : DIRECOES) {
+        uint64_t sequencia = preencher(jogada, oponente, d);
+        // A sequência de peças do oponente só é virada se terminar numa peça do jogador
+        if (desloca(sequencia, d.deslocamento) & d.mascara & proprias) {
+            viradas |= sequencia & ~jogada;
+        }
+    }
+    return viradas;
+}
+
+void ReversiBitboard::aplicar(int indice, int jogador, uint64_t viradas) {
+    uint64_t jogada = 1ULL << indice;
+    pecas_[jogador - 1] |= jogada | viradas;
+    pecas_[2 - jogador] &= ~viradas;
+}
+
+void ReversiBitboard::desfazer(int indice, int jogador, uint64_t viradas) {
+    uint64_t jogada = 1ULL << indice;
+    pecas_[jogador - 1] &= ~(jogada | viradas);
+    pecas_[2 - jogador] |= viradas;
+}
+
+Lig4Bitboard::Lig4Bitboard(int linhas, int colunas)
+    : linhas_(linhas), colunas_(colunas), posicao_(0), mascara_(0), cheio_(0) {
+    if (cabe(linhas, colunas)) {
+        for (int coluna = 0; coluna < colunas; coluna++) {
+            cheio_ |= coluna_inteira(coluna);
+        }
+    }
+}
+
+int Lig4Bitboard::jogar(int coluna, int jogador) {
+    // A soma propaga o "vai um" pelas casas ocupadas e para na primeira vazia
+    uint64_t nova = (mascara_ + base(coluna)) & coluna_inteira(coluna);
+    mascara_ |= nova;
+    if (jogador == 1) {
+        posicao_ |= nova;
+    }
+    return __builtin_ctzll(nova) - coluna * (linhas_ + 1);
+}
+
+void Lig4Bitboard::desfazer(int coluna) {
+    uint64_t ocupadas = mascara_ & coluna_inteira(coluna);
+    if (ocupadas == 0) return;
+    uint64_t topo_atual = 1ULL << (63 - __builtin_clzll(ocupadas));
+    mascara_ &= ~topo_atual;
+    posicao_ &= ~topo_atual;
+}
+
+bool Lig4Bitboard::alinhado(uint64_t pecas) const {
+    // Deslocamentos: 1 vertical, linhas_ diagonal, linhas_ + 1 horizontal, linhas_ + 2 diagonal
+    const int deslocamentos[4] = {1, linhas_, linhas_ + 1, linhas_ + 2};
+    for (int d : deslocamentos) {
+        uint64_t pares = pecas & (pecas >> d);
+        if (pares & (pares >> (2 * d))) return true;
+    }
+    return false;
+}
+
+int Lig4Bitboard::vencedor() const {
+    if (alinhou(1)) return 1;
+    if (alinhou(2)) return 2;
+    return 0;
+}
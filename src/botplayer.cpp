@@ -4,253 +4,752 @@
 */
 
 #include "botplayer.hpp"
+#include "threadpool.hpp"
+#include "finalreversi.hpp"
+#include "tabelavelha.hpp"
 #include <climits>
 #include <algorithm>
 
-// --- Implementação do Jogo da Velha Bot ---
+// --- Busca negamax compartilhada ---
 
 /**
- * @brief Calcula a melhor jogada para o Jogo da Velha utilizando o algoritmo Minimax.
- * @param jogo Estado atual do jogo.
- * @param melhorLinha Referência para armazenar a linha da melhor jogada.
- * @param melhorColuna Referência para armazenar a coluna da melhor jogada.
- * @param jogador ID do jogador atual.
+ * @brief Busca negamax com poda alfa-beta, fazendo e desfazendo jogadas sobre o próprio tabuleiro.
+ * @param jogo Estado atual do jogo (é restaurado ao final da chamada).
+ * @param profundidade Número de jogadas que ainda serão exploradas.
+ * @param alfa Menor pontuação já garantida para o jogador.
+ * @param beta Maior pontuação que o oponente ainda permite.
+ * @param jogador ID do jogador que faz a próxima jogada.
+ * @param ply Distância até a raiz da busca (vitórias mais rápidas valem mais).
+ * @param contexto Contador de nós e jogadas assassinas desta busca.
+ * @return Pontuação da posição do ponto de vista do jogador.
  */
-void JogoDaVelhaBot::minimax(const JogoDaVelha& jogo, int& melhorLinha, int& melhorColuna, int jogador) {
-    int melhorPontuacao = INT_MIN;
-
-    for (int i = 0; i < jogo.getLinhas(); i++) {
-        for (int j = 0; j < jogo.getColunas(); j++) {
-            if (jogo.get_casa(i, j) == 0) { // Se a casa está vazia
-                JogoDaVelha copia = jogo;
-                copia.ler_jogada(i, j, jogador);
-
-                int pontuacao = _minimax(copia, 0, false, jogador);
-                if (pontuacao > melhorPontuacao) {
-                    melhorPontuacao = pontuacao;
-                    melhorLinha = i;
-                    melhorColuna = j;
-                }
+int BotPlayer::negamax(JogosDeTabuleiro& jogo, int profundidade, int alfa, int beta, int jogador, int ply, ContextoBusca& contexto) const {
+    contexto.nos++;
+    if (contexto.deveParar()) {
+        return 0; // Valor descartado: a iteração interrompida não é usada
+    }
+
+    // Resultados decididos (vitória/derrota) são guardados relativos a este nó, não à raiz
+    const int DECIDIDO = VITORIA - ContextoBusca::MAX_PLY;
+    uint64_t chave = chavePosicao(jogo, jogador);
+    std::pair<int, int> jogadaTabela(-1, -1);
+    EntradaTT entrada;
+    if (contexto.tabela && contexto.tabela->consultar(chave, entrada)) {
+        jogadaTabela = std::make_pair(entrada.linha, entrada.coluna);
+        if (entrada.profundidade >= profundidade) {
+            int valor = entrada.pontuacao;
+            if (valor >= DECIDIDO) valor -= ply;
+            else if (valor <= -DECIDIDO) valor += ply;
+
+            if (entrada.tipo() == EntradaTT::EXATA) return valor;
+            if (entrada.tipo() == EntradaTT::INFERIOR && valor > alfa) alfa = valor;
+            if (entrada.tipo() == EntradaTT::SUPERIOR && valor < beta) beta = valor;
+            if (alfa >= beta) return valor;
+        }
+    }
+
+    int pontuacao;
+    if (fimDeJogo(jogo, jogador, pontuacao)) {
+        if (pontuacao > 0) return pontuacao - ply;
+        if (pontuacao < 0) return pontuacao + ply;
+        return pontuacao;
+    }
+    if (profundidade <= 0 || ply >= ContextoBusca::MAX_PLY - 1) {
+        return avaliar(jogo, jogador);
+    }
+
+    int oponente = (jogador == 1) ? 2 : 1;
+    std::pair<int, int> jogadas[MAX_JOGADAS];
+    int total = gerarJogadas(jogo, jogador, jogadas);
+
+    if (total == 0) {
+        // Sem jogadas mas o jogo não acabou: o jogador passa a vez
+        return permitePassar() ? -negamax(jogo, profundidade, -beta, -alfa, oponente, ply + 1, contexto)
+                               : avaliar(jogo, jogador);
+    }
+
+    // A melhor jogada guardada na tabela vem primeiro; depois, a que causou corte neste nível em outro ramo
+    int inicio = 0;
+    const std::pair<int, int> preferidas[2] = {jogadaTabela, contexto.assassinas[ply]};
+    for (const auto& preferida : preferidas) {
+        for (int i = inicio; i < total; i++) {
+            if (jogadas[i] == preferida) {
+                std::rotate(jogadas + inicio, jogadas + i, jogadas + i + 1);
+                inicio++;
+                break;
             }
         }
     }
+
+    int alfaOriginal = alfa;
+    int melhor = -INFINITO;
+    std::pair<int, int> melhorJogada = jogadas[0];
+    RegistroJogada registro;
+    for (int i = 0; i < total; i++) {
+        jogo.fazer_jogada(jogadas[i].first, jogadas[i].second, jogador, registro);
+        int valor = -negamax(jogo, profundidade - 1, -beta, -alfa, oponente, ply + 1, contexto);
+        jogo.desfazer_jogada(registro);
+        if (contexto.abortada) {
+            return 0;
+        }
+
+        if (valor > melhor) {
+            melhor = valor;
+            melhorJogada = jogadas[i];
+        }
+        if (valor > alfa) {
+            alfa = valor;
+        }
+        if (alfa >= beta) {
+            contexto.assassinas[ply] = jogadas[i];
+            break;
+        }
+    }
+
+    if (contexto.tabela) {
+        EntradaTT::Tipo tipo = (melhor <= alfaOriginal) ? EntradaTT::SUPERIOR
+                             : (melhor >= beta) ? EntradaTT::INFERIOR : EntradaTT::EXATA;
+        int guardado = melhor;
+        if (guardado >= DECIDIDO) guardado += ply;
+        else if (guardado <= -DECIDIDO) guardado -= ply;
+        contexto.tabela->guardar(chave, profundidade, guardado, tipo, melhorJogada.first, melhorJogada.second);
+    }
+    return melhor;
 }
 
 /**
- * @brief Implementação recursiva do algoritmo Minimax para o Jogo da Velha.
- * @param jogo Estado atual do jogo.
- * @param profundidade Nível de profundidade da árvore de decisão.
- * @param maximizando Indica se é a vez do jogador maximizar ou minimizar a pontuação.
- * @param jogador ID do jogador atual.
- * @return Valor da melhor jogada possível.
+ * @brief Escolhe a melhor jogada com aprofundamento iterativo até o limite indicado.
+ * @param jogo Cópia do jogo sobre a qual a busca faz e desfaz jogadas.
+ * @param jogador ID do jogador que fará a jogada.
+ * @param limite Profundidade máxima, prazo e/ou orçamento de nós.
+ * @return A melhor jogada da última iteração completa (ou a primeira jogada ordenada, se nenhuma
+ *         iteração terminou), ou (-1, -1) se não houver jogadas válidas.
  */
-int JogoDaVelhaBot::_minimax(JogoDaVelha& jogo, int profundidade, bool maximizando, int jogador) {
-    if (jogo.testar_condicao_de_vitoria()) {
-        return maximizando ? -1 : 1; // Vitória do oponente ou do bot
+std::pair<int, int> BotPlayer::buscarMelhorJogada(JogosDeTabuleiro& jogo, int jogador, const LimiteBusca& limite) {
+    ContextoBusca contexto;
+    contexto.tabela = &tabela_;
+    contexto.limite = &limite;
+    tabela_.nova_busca();
+
+    std::pair<int, int> melhorJogada = aprofundar(jogo, jogador, 0, contexto, profundidadeAlcancada_);
+    nosVisitados_ = contexto.nos;
+    return melhorJogada;
+}
+
+/**
+ * @brief Busca paralela: todas as threads aprofundam a mesma posição e trocam resultados pela tabela.
+ * @param pool Threads que executam as buscas auxiliares.
+ * @param copias Uma cópia do jogo por thread; copias[0] é usada pela thread que chama.
+ * @param jogador ID do jogador que fará a jogada.
+ * @param limite Profundidade máxima, prazo e/ou orçamento de nós (por thread).
+ * @return A jogada da thread que completou a iteração mais profunda (a principal, em caso de empate).
+ */
+std::pair<int, int> BotPlayer::buscarEmParalelo(ThreadPool& pool, const std::vector<JogosDeTabuleiro*>& copias,
+                                                int jogador, const LimiteBusca& limite) {
+    int threads = static_cast<int>(copias.size());
+    std::atomic<bool> parar(false);
+    std::vector<ContextoBusca> contextos(threads);
+    std::vector<int> profundidades(threads, 0);
+    std::vector<std::pair<int, int>> jogadas(threads, std::make_pair(-1, -1));
+    tabela_.nova_busca();
+
+    for (ContextoBusca& contexto : contextos) {
+        contexto.tabela = &tabela_;
+        contexto.limite = &limite;
+        contexto.parar = &parar;
     }
 
-    // Verifica empate
-    bool temEspacosVazios = false;
-    for (int i = 0; i < jogo.getLinhas(); i++) {
-        for (int j = 0; j < jogo.getColunas(); j++) {
-            if (jogo.get_casa(i, j) == 0) {
-                temEspacosVazios = true;
-                break;
-            }
+    std::vector<std::future<void>> auxiliares;
+    for (int i = 1; i < threads; i++) {
+        auxiliares.push_back(pool.enviar([this, &copias, &contextos, &profundidades, &jogadas, jogador, i]() {
+            jogadas[i] = aprofundar(*copias[i], jogador, i, contextos[i], profundidades[i]);
+        }));
+    }
+    jogadas[0] = aprofundar(*copias[0], jogador, 0, contextos[0], profundidades[0]);
+
+    // A thread principal terminou: as auxiliares não têm mais a quem ajudar
+    parar.store(true, std::memory_order_relaxed);
+    for (std::future<void>& auxiliar : auxiliares) {
+        auxiliar.get();
+    }
+
+    int escolhida = 0;
+    nosVisitados_ = 0;
+    for (int i = 0; i < threads; i++) {
+        nosVisitados_ += contextos[i].nos;
+        if (profundidades[i] > profundidades[escolhida]) {
+            escolhida = i;
         }
     }
-    if (!temEspacosVazios) return 0; // Empate
+    profundidadeAlcancada_ = profundidades[escolhida];
+    return jogadas[escolhida];
+}
 
-    int melhorPontuacao = maximizando ? INT_MIN : INT_MAX;
-    int outroJogador = (jogador == 1) ? 2 : 1;
+/**
+ * @brief Aprofundamento iterativo de 1 até o limite do contexto, tentando primeiro a melhor jogada
+ *        da iteração anterior.
+ * @param jogo Cópia do jogo sobre a qual a busca faz e desfaz jogadas.
+ * @param jogador ID do jogador que fará a jogada.
+ * @param auxiliar 0 para a thread principal; i > 0 para a i-ésima thread auxiliar da busca paralela.
+ * @param contexto Contexto desta thread (tabela, limite e sinal de parada já preenchidos).
+ * @param profundidadeAlcancada Recebe a profundidade da última iteração completa.
+ * @return A melhor jogada da última iteração completa, ou (-1, -1) se não houver jogadas válidas.
+ */
+std::pair<int, int> BotPlayer::aprofundar(JogosDeTabuleiro& jogo, int jogador, int auxiliar,
+                                          ContextoBusca& contexto, int& profundidadeAlcancada) const {
+    std::pair<int, int> jogadas[MAX_JOGADAS];
+    int total = gerarJogadas(jogo, jogador, jogadas);
+    profundidadeAlcancada = 0;
 
-    for (int i = 0; i < jogo.getLinhas(); i++) {
-        for (int j = 0; j < jogo.getColunas(); j++) {
-            if (jogo.get_casa(i, j) == 0) { // Se a casa está vazia
-                JogoDaVelha copia = jogo;
-                copia.ler_jogada(i, j, maximizando ? jogador : outroJogador);
+    if (total == 0) {
+        return {-1, -1};
+    }
 
-                int pontuacao = _minimax(copia, profundidade + 1, !maximizando, jogador);
-                if (maximizando) {
-                    melhorPontuacao = std::max(melhorPontuacao, pontuacao);
-                } else {
-                    melhorPontuacao = std::min(melhorPontuacao, pontuacao);
-                }
+    // Auxiliares exploram a raiz em outra ordem e metade delas pula a primeira profundidade
+    std::rotate(jogadas, jogadas + auxiliar % total, jogadas + total);
+    int primeira = 1 + auxiliar % 2;
+
+    int oponente = (jogador == 1) ? 2 : 1;
+    std::pair<int, int> melhorJogada = jogadas[0];
+    RegistroJogada registro;
+    int profundidadeMaxima = std::min(contexto.limite->profundidade, ContextoBusca::MAX_PLY - 1);
+
+    for (int p = std::min(primeira, profundidadeMaxima); p <= profundidadeMaxima && !contexto.abortada; p++) {
+        // A melhor jogada da iteração anterior é explorada primeiro
+        std::pair<int, int>* anterior = std::find(jogadas, jogadas + total, melhorJogada);
+        std::rotate(jogadas, anterior, anterior + 1);
+
+        int alfa = -INFINITO;
+        std::pair<int, int> melhorDaIteracao = jogadas[0];
+        for (int i = 0; i < total && !contexto.abortada; i++) {
+            jogo.fazer_jogada(jogadas[i].first, jogadas[i].second, jogador, registro);
+            int valor = -negamax(jogo, p - 1, -INFINITO, -alfa, oponente, 1, contexto);
+            jogo.desfazer_jogada(registro);
+
+            if (!contexto.abortada && valor > alfa) {
+                alfa = valor;
+                melhorDaIteracao = jogadas[i];
             }
         }
+        if (contexto.abortada) {
+            break; // Iteração incompleta: fica a jogada da anterior
+        }
+        melhorJogada = melhorDaIteracao;
+        profundidadeAlcancada = p;
+
+        // Resultado forçado encontrado: aprofundar não muda a escolha
+        if (alfa >= VITORIA - ContextoBusca::MAX_PLY || alfa <= -VITORIA + ContextoBusca::MAX_PLY) {
+            break;
+        }
     }
-    return melhorPontuacao;
+    return melhorJogada;
 }
 
-std::pair<int, int> JogoDaVelhaBot::calcularProximaJogada(const JogosDeTabuleiro& jogoBase, int jogadorAtual) {
-    const JogoDaVelha& jogo = static_cast<const JogoDaVelha&>(jogoBase); 
-    int melhorLinha = -1, melhorColuna = -1;
-    minimax(jogo, melhorLinha, melhorColuna, jogadorAtual);
-    return {melhorLinha, melhorColuna};
-}
+// --- Implementação do Jogo da Velha Bot ---
 
+JogoDaVelhaBot::JogoDaVelhaBot(int profundidade) : profundidade_(profundidade) {}
 
-std::pair<int, int> Lig4Bot::calcularProximaJogada(const JogosDeTabuleiro& jogoBase, int jogadorAtual) {
-    const Lig4& jogo = static_cast<const Lig4&>(jogoBase);
-    std::vector<int> colunasValidas;
+std::pair<int, int> JogoDaVelhaBot::calcularProximaJogada(const JogosDeTabuleiro& jogoBase, int jogadorAtual) {
+    // Tabuleiros pequenos são resolvidos até o fim; nos grandes, a busca para em profundidade_
+    int casas = jogoBase.getLinhas() * jogoBase.getColunas();
+    int profundidade = (casas <= CASAS_BUSCA_COMPLETA) ? casas : profundidade_;
+    return calcularProximaJogada(jogoBase, jogadorAtual, LimiteBusca::porProfundidade(profundidade));
+}
 
-    for (int coluna = 0; coluna < jogo.getColunas(); ++coluna) {
-        if (jogo.verificar_jogada(0, coluna, jogadorAtual)) {
-            colunasValidas.push_back(coluna);
-        }
+std::pair<int, int> JogoDaVelhaBot::calcularProximaJogada(const JogosDeTabuleiro& jogoBase, int jogadorAtual, const LimiteBusca& limite) {
+    std::pair<int, int> jogada;
+    if (consultarTabela(jogoBase, jogadorAtual, limite, jogada)) {
+        return jogada;
     }
+    JogoDaVelha copia = static_cast<const JogoDaVelha&>(jogoBase); // Única cópia: a busca faz e desfaz jogadas sobre ela
+    return buscarMelhorJogada(copia, jogadorAtual, limite);
+}
 
-    if (colunasValidas.empty()) {
-        std::cerr << "Erro: Nenhuma jogada válida disponível para o bot.\n";
-        return {-1, -1};  // Retorna valores inválidos para indicar erro
+/**
+ * @brief Jogada perfeita do tabuleiro 3x3 lida da tabela pré-calculada, sem busca.
+ * @param jogo Estado atual do jogo.
+ * @param jogador ID do jogador que fará a jogada.
+ * @param limite A tabela equivale à busca completa: só é usada se a profundidade pedida alcança o fim do jogo.
+ * @param jogada Recebe a jogada da tabela.
+ * @return false se o jogo não é o 3x3 com k = 3, se a posição já é final ou se a busca pedida é mais rasa.
+ */
+bool JogoDaVelhaBot::consultarTabela(const JogosDeTabuleiro& jogo, int jogador, const LimiteBusca& limite,
+                                     std::pair<int, int>& jogada) {
+    if (jogo.getLinhas() != 3 || jogo.getColunas() != 3 || static_cast<const JogoDaVelha&>(jogo).getK() != 3) {
+        return false;
     }
+    int codigo = 0, vazias = 0;
+    for (int casa = TabelaVelha::CASAS - 1; casa >= 0; casa--) {
+        int valor = jogo.at(casa / 3, casa % 3);
+        codigo = codigo * 3 + valor;
+        if (valor == 0) vazias++;
+    }
+    const JogadaVelha& entrada = tabelaVelha().consultar(codigo, jogador);
+    if (entrada.casa < 0 || limite.profundidade < vazias) {
+        return false;
+    }
+    nosVisitados_ = 1;
+    profundidadeAlcancada_ = vazias;
+    jogada = std::make_pair(entrada.casa / 3, entrada.casa % 3);
+    return true;
+}
+
+/**
+ * @brief Peso de uma sequência de "pecas" peças de um jogador numa janela de k casas sem peças do oponente.
+ *        A janela com k - 1 peças é uma ameaça de vitória na próxima jogada.
+ */
+int JogoDaVelhaBot::pesoSequencia(int pecas, int k) {
+    if (pecas <= 0) return 0;
+    if (pecas >= k - 1) return 4096;
+    return 1 << std::min(3 * (pecas - 1), 9);
+}
 
-    int melhorColuna = -1;
-    int melhorPontuacao = INT_MIN;
+/**
+ * @brief Gera as casas vazias a até duas casas de alguma peça (o centro, se o tabuleiro estiver vazio),
+ *        ordenadas pelas ameaças que criam ou bloqueiam: as sequências, próprias e do oponente, que passam por elas.
+ */
+int JogoDaVelhaBot::gerarJogadas(const JogosDeTabuleiro& jogoBase, int jogador, std::pair<int, int>* jogadas) const {
+    const JogoDaVelha& jogo = static_cast<const JogoDaVelha&>(jogoBase);
+    int linhas = jogo.getLinhas(), colunas = jogo.getColunas(), k = jogo.getK();
+    int oponente = (jogador == 1) ? 2 : 1;
+    const int DISTANCIA = 2;
+
+    // Casa a até DISTANCIA de alguma peça, testada na vizinhança da própria casa: a busca chama
+    // gerarJogadas em todo nó, e um vetor de marcas alocaria memória em cada um
+    auto perto = [&](int i, int j) {
+        for (int l = std::max(0, i - DISTANCIA); l <= std::min(linhas - 1, i + DISTANCIA); l++) {
+            for (int c = std::max(0, j - DISTANCIA); c <= std::min(colunas - 1, j + DISTANCIA); c++) {
+                if (jogo.at(l, c) != 0) return true;
+            }
+        }
+        return false;
+    };
+
+    const int direcoes[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+    int pesos[MAX_JOGADAS];
+    int total = 0;
+    bool vazio = true;
+    for (int i = 0; i < linhas; i++) {
+        for (int j = 0; j < colunas; j++) {
+            if (jogo.at(i, j) != 0) {
+                vazio = false;
+                continue;
+            }
+            if (!perto(i, j)) continue;
 
-    for (int coluna : colunasValidas) {
-        Lig4 copia = jogo;
-        copia.ler_jogada(0, coluna, jogadorAtual);
-        int pontuacao = minimax(copia, 3, false, jogadorAtual);
+            // Ataque e defesa: sequências de cada jogador que a casa completaria
+            int peso = 0;
+            for (const auto& d : direcoes) {
+                peso += pesoSequencia(jogo.contar_sequencia(i, j, d[0], d[1], jogador) - 1, k) * 2;
+                peso += pesoSequencia(jogo.contar_sequencia(i, j, d[0], d[1], oponente) - 1, k);
+            }
+            // Desempate: mais perto do centro
+            peso = peso * 64 - std::abs(2 * i - (linhas - 1)) - std::abs(2 * j - (colunas - 1));
 
-        if (pontuacao > melhorPontuacao) {
-            melhorPontuacao = pontuacao;
-            melhorColuna = coluna;
+            if (total == MAX_JOGADAS) {
+                if (peso <= pesos[total - 1]) continue;
+                total--; // Descarta a pior para abrir espaço
+            }
+            // Ordenação por inserção, como no ReversiBot
+            int p = total++;
+            while (p > 0 && pesos[p - 1] < peso) {
+                pesos[p] = pesos[p - 1];
+                jogadas[p] = jogadas[p - 1];
+                p--;
+            }
+            pesos[p] = peso;
+            jogadas[p] = std::make_pair(i, j);
         }
     }
+    if (vazio) {
+        if (linhas == 0 || colunas == 0) return 0;
+        jogadas[0] = std::make_pair(linhas / 2, colunas / 2);
+        return 1;
+    }
+    return total;
+}
+
+/**
+ * @brief Avaliação por ameaças: soma, em todas as janelas de k casas, o peso das sequências
+ *        de quem ocupa a janela sozinho. As janelas de cada linha são percorridas deslizando.
+ */
+int JogoDaVelhaBot::avaliar(const JogosDeTabuleiro& jogoBase, int jogador) const {
+    const JogoDaVelha& jogo = static_cast<const JogoDaVelha&>(jogoBase);
+    VisaoTabuleiro tabuleiro = jogo.visao();
+    int k = jogo.getK();
+    int pontuacao = 0;
 
-    if (melhorColuna == -1) {
-        melhorColuna = colunasValidas[rand() % colunasValidas.size()];  // Escolhe uma aleatória
+    const int direcoes[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+    for (const auto& d : direcoes) {
+        // Cada linha da direção começa numa casa cuja anterior está fora do tabuleiro
+        for (int i = 0; i < tabuleiro.linhas; i++) {
+            for (int j = 0; j < tabuleiro.colunas; j++) {
+                int li = i - d[0], cj = j - d[1];
+                if (li >= 0 && li < tabuleiro.linhas && cj >= 0 && cj < tabuleiro.colunas) continue;
+
+                int contagem[3] = {0, 0, 0};
+                int tamanho = 0;
+                for (int l = i, c = j; l < tabuleiro.linhas && c >= 0 && c < tabuleiro.colunas; l += d[0], c += d[1]) {
+                    contagem[tabuleiro(l, c)]++;
+                    if (++tamanho > k) {
+                        contagem[tabuleiro(l - k * d[0], c - k * d[1])]--;
+                    }
+                    if (tamanho < k) continue;
+                    if (contagem[2] == 0) pontuacao += (jogador == 1 ? 1 : -1) * pesoSequencia(contagem[1], k);
+                    else if (contagem[1] == 0) pontuacao += (jogador == 2 ? 1 : -1) * pesoSequencia(contagem[2], k);
+                }
+            }
+        }
     }
+    // Mantém a heurística bem abaixo das pontuações de vitória
+    const int LIMITE = VITORIA / 2;
+    return std::max(-LIMITE, std::min(LIMITE, pontuacao));
+}
 
-    return {0, melhorColuna};  // Retorna a coluna escolhida
+bool JogoDaVelhaBot::fimDeJogo(const JogosDeTabuleiro& jogo, int jogador, int& pontuacao) const {
+    int vencedor = jogo.determinar_vencedor();
+    if (vencedor != 0) {
+        pontuacao = (vencedor == jogador) ? VITORIA : -VITORIA;
+        return true;
+    }
+    pontuacao = 0;
+    return jogo.testar_condicao_de_vitoria(); // Tabuleiro cheio
 }
 
+// --- Implementação do Lig 4 Bot ---
 
+Lig4Bot::Lig4Bot(int profundidade)
+    : profundidade_(profundidade), perfeito_(false), prazoPerfeito_(3000), nosPerfeito_(0) {}
 
-bool Lig4Bot::tabuleiroCheio(const Lig4& jogo) {
-    // Check top row for empty spaces
-    for (int coluna = 0; coluna < jogo.getColunas(); ++coluna) {
-        if (jogo.get_casa(0, coluna) == 0) {
-            return false;
+void Lig4Bot::setModoPerfeito(bool ativo, std::chrono::milliseconds prazo) {
+    perfeito_ = ativo;
+    prazoPerfeito_ = prazo;
+    if (ativo && getTamanhoTabela() < 32) {
+        setTamanhoTabela(32); // O solucionador guarda muito mais posições que a busca heurística
+    }
+}
+
+std::pair<int, int> Lig4Bot::calcularProximaJogada(const JogosDeTabuleiro& jogoBase, int jogadorAtual) {
+    if (perfeito_) {
+        int coluna;
+        LimiteBusca limite = nosPerfeito_ > 0 ? LimiteBusca::porNos(nosPerfeito_) : LimiteBusca::porTempo(prazoPerfeito_);
+        if (resolverPerfeito(static_cast<const Lig4&>(jogoBase), jogadorAtual, limite, coluna)) {
+            return {0, coluna};
         }
     }
-    return true;
+    Lig4 copia = static_cast<const Lig4&>(jogoBase);
+    std::pair<int, int> jogada = buscarMelhorJogada(copia, jogadorAtual, LimiteBusca::porProfundidade(profundidade_));
+    if (jogada.second == -1) {
+        std::cerr << "Erro: Nenhuma jogada válida disponível para o bot.\n";
+        return {-1, -1};
+    }
+    return {0, jogada.second};
+}
+
+std::pair<int, int> Lig4Bot::calcularProximaJogada(const JogosDeTabuleiro& jogoBase, int jogadorAtual, const LimiteBusca& limite) {
+    const Lig4& jogo = static_cast<const Lig4&>(jogoBase);
+    if (perfeito_) {
+        // Com prazo, o solucionador usa até 3/4 do tempo restante e a busca heurística fica com o resto
+        LimiteBusca limiteSolucao = limite;
+        if (limite.prazo != LimiteBusca::Relogio::time_point::max()) {
+            LimiteBusca::Relogio::time_point agora = LimiteBusca::Relogio::now();
+            if (limite.prazo > agora) limiteSolucao.prazo = agora + (limite.prazo - agora) * 3 / 4;
+        }
+        int coluna;
+        if (resolverPerfeito(jogo, jogadorAtual, limiteSolucao, coluna)) {
+            return {0, coluna};
+        }
+    }
+
+    Lig4 copia = jogo; // Única cópia: a busca faz e desfaz jogadas sobre ela
+    std::pair<int, int> jogada = buscarMelhorJogada(copia, jogadorAtual, limite);
+
+    if (jogada.second == -1) {
+        std::cerr << "Erro: Nenhuma jogada válida disponível para o bot.\n";
+        return {-1, -1};  // Retorna valores inválidos para indicar erro
+    }
+    return {0, jogada.second};  // Retorna a coluna escolhida
 }
 
-int Lig4Bot::minimax(Lig4& jogo, int profundidade, bool maximizando, int jogadorAtual) {
-    // Verifica se o jogo acabou
-    if (jogo.testar_condicao_de_vitoria()) {
-        return maximizando ? -100 : 100; // Se for nossa vez e encontramos um tabuleiro vencedor, o oponente venceu
+/**
+ * @brief Jogada perfeita pelo SolucionadorLig4 (apenas no tabuleiro 7x6, sem vencedor).
+ * @param jogo Estado atual do jogo.
+ * @param jogador ID do jogador que fará a jogada.
+ * @param limite Prazo e/ou orçamento de nós do solucionador.
+ * @param coluna Recebe a coluna escolhida.
+ * @return false se o modo não se aplica à posição ou se a solução não terminou dentro do limite.
+ */
+bool Lig4Bot::resolverPerfeito(const Lig4& jogo, int jogador, const LimiteBusca& limite, int& coluna) {
+    const int L = SolucionadorLig4::LARGURA, A = SolucionadorLig4::ALTURA;
+    if (jogo.getLinhas() != A || jogo.getColunas() != L || jogo.determinar_vencedor() != 0) {
+        return false;
+    }
+
+    // Mesmo formato do Lig4Bitboard: 7 bits por coluna, de baixo para cima
+    uint64_t proprias = 0, mascara = 0;
+    for (int c = 0; c < L; c++) {
+        for (int altura = 0; altura < A; altura++) {
+            int casa = jogo.at(A - 1 - altura, c);
+            if (casa == 0) break;
+            uint64_t bit = 1ULL << (c * (A + 1) + altura);
+            mascara |= bit;
+            if (casa == jogador) proprias |= bit;
+        }
     }
 
-    if (tabuleiroCheio(jogo) || profundidade == 0) {
-        return 0; // Empate ou profundidade máxima atingida
+    ContextoBusca contexto;
+    contexto.tabela = &tabela();
+    contexto.limite = &limite;
+    solucionador_.resolver(proprias, mascara, contexto, coluna);
+    nosVisitados_ = contexto.nos;
+    if (contexto.abortada || coluna < 0) {
+        return false;
     }
+    profundidadeAlcancada_ = L * A - ReversiBitboard::contar(mascara);
+    return true;
+}
 
-    int melhorPontuacao = maximizando ? INT_MIN : INT_MAX;
-    int proximoJogador = maximizando ? jogadorAtual : (jogadorAtual == 1 ? 2 : 1);
+/**
+ * @brief Gera as colunas livres começando pelo centro e indo para as bordas.
+ */
+int Lig4Bot::gerarJogadas(const JogosDeTabuleiro& jogo, int jogador, std::pair<int, int>* jogadas) const {
+    int colunas = jogo.getColunas();
+    int centro = colunas / 2;
+    int total = 0;
+
+    for (int k = 0; k < colunas; k++) {
+        int deslocamento = (k + 1) / 2;
+        int coluna = (k % 2 == 1) ? centro - deslocamento : centro + deslocamento;
+        if (coluna >= 0 && coluna < colunas && jogo.verificar_jogada(0, coluna, jogador)) {
+            jogadas[total++] = std::make_pair(0, coluna);
+        }
+    }
+    return total;
+}
 
-    for (int coluna = 0; coluna < jogo.getColunas(); ++coluna) {
-        if (jogo.verificar_jogada(0, coluna, proximoJogador)) {
-            Lig4 copia = jogo;
-            copia.ler_jogada(0, coluna, proximoJogador);
+/**
+ * @brief Avalia as janelas de quatro casas: sequências abertas de 2 e 3 peças e o controle da coluna central.
+ */
+int Lig4Bot::avaliar(const JogosDeTabuleiro& jogo, int jogador) const {
+    VisaoTabuleiro tabuleiro = jogo.visao();
+    int oponente = (jogador == 1) ? 2 : 1;
+    int pontuacao = 0;
 
-            int pontuacao = minimax(copia, profundidade - 1, !maximizando, jogadorAtual);
+    int centro = tabuleiro.colunas / 2;
+    for (int linha = 0; linha < tabuleiro.linhas; linha++) {
+        if (tabuleiro(linha, centro) == jogador) pontuacao += 3;
+        else if (tabuleiro(linha, centro) == oponente) pontuacao -= 3;
+    }
 
-            if (maximizando) {
-                melhorPontuacao = std::max(melhorPontuacao, pontuacao);
-            } else {
-                melhorPontuacao = std::min(melhorPontuacao, pontuacao);
+    const int direcoes[4][2] = {{0, 1}, {1, 0}, {1, 1}, {-1, 1}};
+    for (int linha = 0; linha < tabuleiro.linhas; linha++) {
+        for (int coluna = 0; coluna < tabuleiro.colunas; coluna++) {
+            for (const auto& d : direcoes) {
+                int linhaFinal = linha + 3 * d[0];
+                int colunaFinal = coluna + 3 * d[1];
+                if (linhaFinal < 0 || linhaFinal >= tabuleiro.linhas || colunaFinal >= tabuleiro.colunas) continue;
+
+                int proprias = 0, doOponente = 0;
+                for (int k = 0; k < 4; k++) {
+                    int casa = tabuleiro(linha + k * d[0], coluna + k * d[1]);
+                    if (casa == jogador) proprias++;
+                    else if (casa == oponente) doOponente++;
+                }
+                if (doOponente == 0) {
+                    if (proprias == 3) pontuacao += 5;
+                    else if (proprias == 2) pontuacao += 2;
+                } else if (proprias == 0) {
+                    if (doOponente == 3) pontuacao -= 5;
+                    else if (doOponente == 2) pontuacao -= 2;
+                }
             }
         }
     }
+    return pontuacao;
+}
 
-    return melhorPontuacao;
+bool Lig4Bot::fimDeJogo(const JogosDeTabuleiro& jogo, int jogador, int& pontuacao) const {
+    int vencedor = jogo.determinar_vencedor();
+    if (vencedor != 0) {
+        pontuacao = (vencedor == jogador) ? VITORIA : -VITORIA;
+        return true;
+    }
+    pontuacao = 0;
+    return jogo.testar_condicao_de_vitoria(); // Tabuleiro cheio
 }
 
 // --- Implementação Atualizada do Reversi Bot ---
 
+namespace {
+
+/// Prazo da solução exata do final quando a jogada não tem outro limite.
+const std::chrono::milliseconds PRAZO_FINAL_PADRAO(1000);
+
+} // namespace
+
+ReversiBot::ReversiBot(int profundidade, ThreadPool* pool)
+    : pool_(pool), threads_(pool ? pool->getThreads() + 1 : 1), profundidade_(profundidade), limiarFinal_(14),
+      prazoFinal_(PRAZO_FINAL_PADRAO), nosFinal_(0) {}
+
 std::pair<int, int> ReversiBot::calcularProximaJogada(const JogosDeTabuleiro& jogoBase, int jogadorAtual) {
+    return calcularProximaJogada(jogoBase, jogadorAtual, LimiteBusca::porProfundidade(profundidade_));
+}
+
+std::pair<int, int> ReversiBot::calcularProximaJogada(const JogosDeTabuleiro& jogoBase, int jogadorAtual, const LimiteBusca& limite) {
     const Reversi& jogo = static_cast<const Reversi&>(jogoBase);
-    std::vector<std::pair<int, int>> jogadasValidas;
-    
-    // Coletar todas as jogadas válidas primeiro
-    for (int linha = 0; linha < jogo.getLinhas(); linha++) {
-        for (int coluna = 0; coluna < jogo.getColunas(); coluna++) {
-            if (jogo.verificar_jogada(linha, coluna, jogadorAtual)) {
-                jogadasValidas.emplace_back(linha, coluna);
-            }
-        }
+    std::pair<int, int> jogadaFinal;
+    if (resolverFinal(jogo, jogadorAtual, limite, jogadaFinal)) {
+        return jogadaFinal;
     }
-    
-    // Se não houver jogadas válidas, retornar (-1, -1)
-    if (jogadasValidas.empty()) {
-        return {-1, -1};
+    if (pool_ == nullptr || threads_ == 1) {
+        Reversi copia = jogo; // Única cópia: a busca faz e desfaz jogadas sobre ela
+        return buscarMelhorJogada(copia, jogadorAtual, limite);
     }
 
-    int melhorPontuacao = INT_MIN;
-    std::pair<int, int> melhorJogada = jogadasValidas[0];
+    // Uma cópia por thread, criadas uma vez por jogada
+    std::vector<Reversi> copias(threads_, jogo);
+    std::vector<JogosDeTabuleiro*> ponteiros;
+    for (Reversi& copia : copias) {
+        ponteiros.push_back(&copia);
+    }
+    return buscarEmParalelo(*pool_, ponteiros, jogadorAtual, limite);
+}
 
-    // Avaliar apenas as jogadas válidas
-    for (const auto& jogada : jogadasValidas) {
-        Reversi copia = jogo;
-        copia.ler_jogada(jogada.first, jogada.second, jogadorAtual);
-        
-        int pontuacao = _minimax(copia, 0, false, jogadorAtual);
-        
-        if (pontuacao > melhorPontuacao) {
-            melhorPontuacao = pontuacao;
-            melhorJogada = jogada;
+/**
+ * @brief Solução exata do final com o SolucionadorFinalReversi (diferença de peças, jogo perfeito).
+ * @param jogo Estado atual do jogo.
+ * @param jogador ID do jogador que fará a jogada.
+ * @param limite Prazo e/ou orçamento de nós; a profundidade é ignorada (a busca vai até o fim). Sem
+ *        prazo nem orçamento, a solução tem getNosFinal() nós ou, se for 0, até getPrazoFinal()
+ *        (padrão: 1 s) para terminar.
+ * @param jogada Recebe a melhor jogada.
+ * @return true se a jogada foi encontrada; false se o final não se aplica ou a busca foi interrompida.
+ */
+bool ReversiBot::resolverFinal(const Reversi& jogo, int jogador, const LimiteBusca& limite, std::pair<int, int>& jogada) {
+    if (jogo.getLinhas() != 8 || jogo.getColunas() != 8) {
+        return false;
+    }
+    uint64_t pecas[2] = {0, 0};
+    for (int linha = 0; linha < 8; linha++) {
+        for (int coluna = 0; coluna < 8; coluna++) {
+            int casa = jogo.at(linha, coluna);
+            if (casa != 0) pecas[casa - 1] |= ReversiBitboard::bit(linha, coluna);
         }
     }
+    int vazias = ReversiBitboard::contar(~(pecas[0] | pecas[1]));
+    if (vazias > limiarFinal_) {
+        return false;
+    }
 
-    return melhorJogada;
+    // Uma busca até o fim sem limite pode levar segundos com muitas vazias: o prazo padrão a encerra
+    bool semLimite = limite.maxNos <= 0 && limite.prazo == LimiteBusca::Relogio::time_point::max();
+    LimiteBusca limitePadrao = nosFinal_ > 0 ? LimiteBusca::porNos(nosFinal_) : LimiteBusca::porTempo(prazoFinal_);
+
+    ContextoBusca contexto;
+    contexto.tabela = &tabela();
+    contexto.limite = semLimite ? &limitePadrao : &limite;
+    tabela().nova_busca();
+    SolucionadorFinalReversi solucionador(contexto);
+    int casa;
+    solucionador.resolver(pecas[jogador - 1], pecas[2 - jogador], casa);
+
+    nosVisitados_ = contexto.nos;
+    if (contexto.abortada || casa < 0) {
+        return false;
+    }
+    profundidadeAlcancada_ = vazias;
+    jogada = std::make_pair(casa / 8, casa % 8);
+    return true;
 }
 
-int ReversiBot::_minimax(Reversi& jogo, int profundidade, bool maximizando, int jogadorAtual) {
-    if (jogo.testar_condicao_de_vitoria() || profundidade >= 4) { 
-        return _avaliarTabuleiro(jogo, jogadorAtual);
-    }
+/**
+ * @brief Peso posicional de uma casa: cantos valem mais, casas vizinhas aos cantos são perigosas.
+ */
+int ReversiBot::_pesoCasa(const JogosDeTabuleiro& jogo, int linha, int coluna) {
+    int ultimaLinha = jogo.getLinhas() - 1;
+    int ultimaColuna = jogo.getColunas() - 1;
+    bool bordaLinha = (linha == 0 || linha == ultimaLinha);
+    bool bordaColuna = (coluna == 0 || coluna == ultimaColuna);
+
+    if (bordaLinha && bordaColuna) return 100; // Canto
+    int distanciaLinha = std::min(linha, ultimaLinha - linha);
+    int distanciaColuna = std::min(coluna, ultimaColuna - coluna);
+    if (distanciaLinha <= 1 && distanciaColuna <= 1) return -20; // Vizinha de canto
+    if (bordaLinha || bordaColuna) return 10;
+    return 1;
+}
 
-    int melhorPontuacao = maximizando ? INT_MIN : INT_MAX;
-    int jogador = maximizando ? jogadorAtual : (jogadorAtual == 1 ? 2 : 1);
+/**
+ * @brief Gera as jogadas válidas ordenadas pelo peso posicional (cantos primeiro).
+ */
+int ReversiBot::gerarJogadas(const JogosDeTabuleiro& jogo, int jogador, std::pair<int, int>* jogadas) const {
+    int pesos[MAX_JOGADAS];
+    int total = 0;
+
+    auto inserir = [&](int linha, int coluna) {
+        // Ordenação por inserção: as listas de jogadas são curtas
+        int peso = _pesoCasa(jogo, linha, coluna);
+        int i = total++;
+        while (i > 0 && pesos[i - 1] < peso) {
+            pesos[i] = pesos[i - 1];
+            jogadas[i] = jogadas[i - 1];
+            i--;
+        }
+        pesos[i] = peso;
+        jogadas[i] = std::make_pair(linha, coluna);
+    };
+
+    const Reversi& reversi = static_cast<const Reversi&>(jogo);
+    if (reversi.usa_bitboard()) {
+        // Mesma ordem da varredura linha a linha, sem testar as casas uma a uma
+        for (uint64_t resto = reversi.mascara_jogadas(jogador); resto; resto &= resto - 1) {
+            int casa = __builtin_ctzll(resto);
+            inserir(casa / 8, casa % 8);
+        }
+        return total;
+    }
 
-    // Iterar sobre todas as jogadas válidas
-    for (int linha = 0; linha < jogo.getLinhas(); linha++) {
-        for (int coluna = 0; coluna < jogo.getColunas(); coluna++) {
+    for (int linha = 0; linha < jogo.getLinhas() && total < MAX_JOGADAS; linha++) {
+        for (int coluna = 0; coluna < jogo.getColunas() && total < MAX_JOGADAS; coluna++) {
             if (jogo.verificar_jogada(linha, coluna, jogador)) {
-                jogo.ler_jogada(linha, coluna, jogador);
-
-                // Chamada recursiva para Minimax
-                int pontuacao = _minimax(jogo, profundidade + 1, !maximizando, jogadorAtual);
-
-                //jogo.desfazer_jogada(linha, coluna);
-
-                if (maximizando) {
-                    melhorPontuacao = std::max(melhorPontuacao, pontuacao);
-                } else {
-                    melhorPontuacao = std::min(melhorPontuacao, pontuacao);
-                }
+                inserir(linha, coluna);
             }
         }
     }
+    return total;
+}
 
-    return melhorPontuacao;
+int ReversiBot::avaliar(const JogosDeTabuleiro& jogo, int jogador) const {
+    return _avaliarTabuleiro(static_cast<const Reversi&>(jogo), jogador);
+}
+
+bool ReversiBot::fimDeJogo(const JogosDeTabuleiro& jogo, int jogador, int& pontuacao) const {
+    if (!jogo.testar_condicao_de_vitoria()) {
+        return false;
+    }
+    std::pair<int, int> pontos = static_cast<const Reversi&>(jogo).calcular_pontuacao();
+    int diferenca = (jogador == 1) ? pontos.first - pontos.second : pontos.second - pontos.first;
+    pontuacao = (diferenca > 0) ? VITORIA + diferenca : (diferenca < 0) ? -VITORIA + diferenca : 0;
+    return true;
 }
 
 // Método para avaliar o tabuleiro
-int ReversiBot::_avaliarTabuleiro(const Reversi& jogo, int jogadorAtual) {
+int ReversiBot::_avaliarTabuleiro(const Reversi& jogo, int jogadorAtual) const {
     int oponente = (jogadorAtual == 1) ? 2 : 1;
     int pontuacao = 0;
 
     int mobilidadeJogador = 0;
     int mobilidadeOponente = 0;
 
-    for (int linha = 0; linha < jogo.getLinhas(); linha++) {
-        for (int coluna = 0; coluna < jogo.getColunas(); coluna++) {
-            if (jogo.verificar_jogada(linha, coluna, jogadorAtual)) mobilidadeJogador++;
-            if (jogo.verificar_jogada(linha, coluna, oponente)) mobilidadeOponente++;
+    if (jogo.usa_bitboard()) {
+        mobilidadeJogador = ReversiBitboard::contar(jogo.mascara_jogadas(jogadorAtual));
+        mobilidadeOponente = ReversiBitboard::contar(jogo.mascara_jogadas(oponente));
+    } else {
+        for (int linha = 0; linha < jogo.getLinhas(); linha++) {
+            for (int coluna = 0; coluna < jogo.getColunas(); coluna++) {
+                if (jogo.verificar_jogada(linha, coluna, jogadorAtual)) mobilidadeJogador++;
+                if (jogo.verificar_jogada(linha, coluna, oponente)) mobilidadeOponente++;
+            }
         }
     }
     pontuacao += (mobilidadeJogador - mobilidadeOponente) * 2;
@@ -258,7 +757,7 @@ int ReversiBot::_avaliarTabuleiro(const Reversi& jogo, int jogadorAtual) {
     // Controle de cantos e bordas
     for (int linha = 0; linha < jogo.getLinhas(); linha++) {
         for (int coluna = 0; coluna < jogo.getColunas(); coluna++) {
-            int casa = jogo.get_casa(linha, coluna);
+            int casa = jogo.at(linha, coluna);
             if (casa == jogadorAtual) {
                 if ((linha == 0 || linha == jogo.getLinhas() - 1) &&
                     (coluna == 0 || coluna == jogo.getColunas() - 1)) {
@@ -284,4 +783,4 @@ int ReversiBot::_avaliarTabuleiro(const Reversi& jogo, int jogadorAtual) {
     }
 
     return pontuacao;
-}
\ No newline at end of file
+}
@@ -4,10 +4,55 @@
  */
 
 #include "cadastro.hpp"
+#include "cadastrobinario.hpp"
 #include "cores.hpp"
+#include "threadpool.hpp"
 #include <stdexcept>
 #include <sstream>
 #include <iomanip>
+#include <cerrno>
+#include <cctype>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <future>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const std::size_t Cadastro::MIN_REGISTROS_DIARIO;
+
+namespace {
+
+/// Sincroniza o diretório do arquivo, para que uma renomeação sobreviva a uma queda.
+void sincronizarDiretorio(const std::string& caminho) {
+    std::size_t barra = caminho.find_last_of('/');
+    std::string diretorio = (barra == std::string::npos) ? "." : (barra == 0 ? "/" : caminho.substr(0, barra));
+    int descritor = ::open(diretorio.c_str(), O_RDONLY);
+    if (descritor < 0) return; // Sem acesso ao diretório: a renomeação já foi feita
+    ::fsync(descritor);
+    ::close(descritor);
+}
+
+/// Tamanho do diário até o último '\n' (o fim do último registro completo), ou -1 em caso de erro.
+off_t fimDoUltimoRegistro(int descritor, off_t tamanho) {
+    char bloco[4096];
+    off_t fim = tamanho;
+    while (fim > 0) {
+        off_t inicio = fim > static_cast<off_t>(sizeof(bloco)) ? fim - static_cast<off_t>(sizeof(bloco)) : 0;
+        ssize_t lidos = ::pread(descritor, bloco, static_cast<std::size_t>(fim - inicio), inicio);
+        if (lidos != fim - inicio) return -1;
+        for (off_t i = lidos; i > 0; i--) {
+            if (bloco[i - 1] == '\n') return inicio + i;
+        }
+        fim = inicio;
+    }
+    return 0;
+}
+
+} // namespace
 
 
 /**
@@ -28,6 +73,42 @@ std::string Jogador::serializar() const {
     }
 }
 
+namespace {
+
+/// Nomes dos campos numéricos, na ordem da linha serializada, para as mensagens de erro.
+const char* const CAMPOS_NUMERICOS[6] = {
+    "vitórias do jogo da velha", "derrotas do jogo da velha",
+    "vitórias do Lig 4", "derrotas do Lig 4",
+    "vitórias do Reversi", "derrotas do Reversi"
+};
+
+/**
+ * @brief Converte um número como std::stoi (espaços no começo, sinal opcional, dígitos; o que vier
+ *        depois é ignorado), mas sem criar strings.
+ * @return false se não houver número ou se ele não couber em um int.
+ */
+bool converterInteiro(const char* p, const char* fim, int& valor) {
+    while (p < fim && std::isspace(static_cast<unsigned char>(*p))) ++p;
+    bool negativo = false;
+    if (p < fim && (*p == '+' || *p == '-')) {
+        negativo = (*p == '-');
+        ++p;
+    }
+    if (p == fim || *p < '0' || *p > '9') return false;
+
+    long long total = 0;
+    for (; p < fim && *p >= '0' && *p <= '9'; ++p) {
+        total = total * 10 + (*p - '0');
+        if (total > static_cast<long long>(INT_MAX) + 1) return false;
+    }
+    if (negativo) total = -total;
+    if (total > INT_MAX || total < INT_MIN) return false;
+    valor = static_cast<int>(total);
+    return true;
+}
+
+} // namespace
+
 /**
  * @brief Cria um objeto Jogador a partir de uma string serializada
  * @param linha String contendo os dados do jogador
@@ -36,60 +117,94 @@ std::string Jogador::serializar() const {
  * @throw std::runtime_error Se houver erro na conversão dos dados
  */
 Jogador Jogador::deserializar(const std::string& linha) {
-    if (linha.empty()) {
-        //throw std::invalid_argument("String de entrada vazia para deserialização");
-    }
-
-    std::vector<std::string> campos;
-    std::size_t inicio = 0;
-    std::size_t pos = 0;
+    Jogador jogador;
+    jogador.preencher(linha.data(), linha.data() + linha.size());
+    return jogador;
+}
 
-    try {
-        while ((pos = linha.find(',', inicio)) != std::string::npos) {
-            campos.push_back(linha.substr(inicio, pos - inicio));
-            inicio = pos + 1;
+/**
+ * @brief Lê os campos de uma linha serializada neste jogador
+ * @param inicio Primeiro caractere da linha
+ * @param fim Posição depois do último caractere (sem o '\n')
+ * @throw std::runtime_error Se a linha tiver formato inválido ou algum número inválido
+ */
+void Jogador::preencher(const char* inicio, const char* fim) {
+    // Início de cada um dos 8 campos; o campo i termina um caractere antes do início do campo i + 1
+    const char* campos[9];
+    int encontrados = 1;
+    campos[0] = inicio;
+    for (const char* p = inicio; p < fim; ++p) {
+        if (*p == ',') {
+            if (encontrados < 8) campos[encontrados] = p + 1;
+            ++encontrados;
         }
-        campos.push_back(linha.substr(inicio));
+    }
 
-        if (campos.size() != 8) {
+    try {
+        if (encontrados != 8) {
             throw std::invalid_argument(
-                std::string("Formato inválido na string de entrada: esperado 8 campos, encontrado ") + 
-                std::to_string(campos.size()));
+                std::string("Formato inválido na string de entrada: esperado 8 campos, encontrado ") +
+                std::to_string(encontrados));
         }
+        campos[8] = fim + 1;
 
-        if (campos[0].empty() || campos[1].empty()) {
+        if (campos[1] - 1 == campos[0] || campos[2] - 1 == campos[1]) {
             throw std::invalid_argument("Nome ou apelido não podem estar vazios");
         }
 
-        auto convertAndValidate = [&](const std::string& str, const std::string& field) -> int {
-            try {
-                int value = std::stoi(str);
-                if (value < 0) {
-                    throw std::invalid_argument(field + " não pode ser negativo");
-                }
-                return value;
-            } catch (const std::exception& e) {
-                throw std::runtime_error(field + ": " + e.what());
+        int valores[6];
+        for (int i = 0; i < 6; i++) {
+            // As mensagens (só montadas em caso de erro) são as mesmas da conversão com std::stoi
+            if (!converterInteiro(campos[i + 2], campos[i + 3] - 1, valores[i])) {
+                throw std::runtime_error(std::string(CAMPOS_NUMERICOS[i]) + ": stoi");
             }
-        };
-
-        int velhaVitorias = convertAndValidate(campos[2], "vitórias do jogo da velha");
-        int velhaDerrotas = convertAndValidate(campos[3], "derrotas do jogo da velha");
-        int lig4Vitorias = convertAndValidate(campos[4], "vitórias do Lig 4");
-        int lig4Derrotas = convertAndValidate(campos[5], "derrotas do Lig 4");
-        int reversiVitorias = convertAndValidate(campos[6], "vitórias do Reversi");
-        int reversiDerrotas = convertAndValidate(campos[7], "derrotas do Reversi");
+            if (valores[i] < 0) {
+                const std::string campo = CAMPOS_NUMERICOS[i];
+                throw std::runtime_error(campo + ": " + campo + " não pode ser negativo");
+            }
+        }
 
-        return Jogador(campos[0], campos[1], 
-                      velhaVitorias, velhaDerrotas,
-                      lig4Vitorias, lig4Derrotas,
-                      reversiVitorias, reversiDerrotas);
+        // Só altera o jogador depois de validar a linha inteira
+        _nome.assign(campos[0], campos[1] - 1);
+        _apelido.assign(campos[1], campos[2] - 1);
+        Velha = Winrate{valores[0], valores[1]};
+        Lig4 = Winrate{valores[2], valores[3]};
+        Reversi = Winrate{valores[4], valores[5]};
 
     } catch (const std::exception& e) {
         throw std::runtime_error(std::string("Erro na deserialização: ") + e.what());
     }
 }
 
+/**
+ * @brief Coloca o jogador no fim da lista e no índice, sem registrar no diário
+ * @throw std::invalid_argument Se o apelido já estiver cadastrado
+ */
+void Cadastro::inserir(std::unique_ptr<Jogador> jogador) {
+    auto inserido = _indice.emplace(jogador->getApelido(), _jogadores.size());
+    if (!inserido.second) {
+        throw std::invalid_argument(std::string("Jogador '") + jogador->getApelido() + "' já está cadastrado");
+    }
+    try {
+        _jogadores.push_back(std::move(jogador));
+    } catch (...) {
+        _indice.erase(inserido.first);
+        throw;
+    }
+}
+
+/**
+ * @brief Tira o jogador da posição dada: o último jogador ocupa o seu lugar
+ */
+void Cadastro::retirar(std::size_t posicao) {
+    _indice.erase(_jogadores[posicao]->getApelido());
+    if (posicao + 1 != _jogadores.size()) {
+        _jogadores[posicao] = std::move(_jogadores.back());
+        _indice[_jogadores[posicao]->getApelido()] = posicao;
+    }
+    _jogadores.pop_back();
+}
+
 /**
  * @brief Adiciona um novo jogador ao cadastro
  * @param alvo Jogador a ser adicionado
@@ -97,16 +212,15 @@ Jogador Jogador::deserializar(const std::string& linha) {
  * @throw std::runtime_error Se houver falha na alocação de memória
  */
 void Cadastro::adicionarJogador(const Jogador& alvo) {
-    if (check(alvo)) {
-        throw std::invalid_argument(std::string("Jogador '") + alvo.getApelido() + "' já está cadastrado");
-    }
-
     try {
-        _jogadores.push_back(std::unique_ptr<Jogador>(new Jogador(alvo)));
-        std::cout << "Jogador " << alvo.getApelido() << " cadastrado com sucesso" << std::endl;
+        inserir(std::unique_ptr<Jogador>(new Jogador(alvo)));
+    } catch (const std::invalid_argument& e) {
+        throw;
     } catch (const std::exception& e) {
         throw std::runtime_error(std::string("Erro ao adicionar jogador: ") + e.what());
     }
+    registrar('+', alvo.serializar());
+    if (_verboso) std::cout << "Jogador " << alvo.getApelido() << " cadastrado com sucesso" << std::endl;
 }
 
 /**
@@ -163,6 +277,7 @@ void Cadastro::mostrarJogadores() const {
  * @throw std::invalid_argument Se o arquivo estiver mal formatado
  */
 void Cadastro::import(const std::string& caminho) {
+    if (_diario >= 0) sincronizar(); // O diário em disco precisa estar completo antes de ser aplicado
     std::ifstream arquivo(caminho);
     if (!arquivo.is_open()) {
         //throw std::runtime_error(std::string("Não foi possível abrir o arquivo: ") + caminho);
@@ -170,16 +285,21 @@ void Cadastro::import(const std::string& caminho) {
 
     try {
         _jogadores.clear();
+        _indice.clear();
         std::string linha;
         int lineNumber = 0;
+        std::unique_ptr<Jogador> novo; // Lido direto no objeto que vai para o cadastro
 
         while (std::getline(arquivo, linha)) {
             ++lineNumber;
             if (!linha.empty()) {
                 try {
-                    _jogadores.push_back(
-                        std::unique_ptr<Jogador>(new Jogador(Jogador::deserializar(linha)))
-                    );
+                    if (!novo) novo.reset(new Jogador());
+                    novo->preencher(linha.data(), linha.data() + linha.size());
+                    if (check(*novo)) {
+                        throw std::invalid_argument("Apelido repetido: " + novo->getApelido());
+                    }
+                    inserir(std::move(novo));
                 } catch (const std::exception& e) {
                     throw std::invalid_argument(
                         std::string("Erro na linha ") + std::to_string(lineNumber) + ": " + e.what()
@@ -189,43 +309,286 @@ void Cadastro::import(const std::string& caminho) {
         }
         
         arquivo.close();
-        std::cout << "Jogadores importados com sucesso." << std::endl;
+        aplicarDiario(caminho);
+        if (_verboso) std::cout << "Jogadores importados com sucesso." << std::endl;
 
     } catch (const std::exception& e) {
         arquivo.close();
         _jogadores.clear();
+        _indice.clear();
+        throw std::runtime_error(std::string("Erro na importação: ") + e.what());
+    }
+}
+
+namespace {
+
+/// Jogadores lidos por uma tarefa da importação em paralelo, com as linhas relativas ao seu pedaço.
+struct PedacoImportado {
+    const char* inicio = nullptr;
+    const char* fim = nullptr;
+    std::vector<std::unique_ptr<Jogador>> jogadores;
+    std::vector<int> linhas;   ///< Linha de cada jogador, contada a partir do começo do pedaço
+    int totalLinhas = 0;
+    int linhaErro = 0;         ///< 0 = sem erro
+    std::string erro;
+};
+
+/// Lê as linhas de um pedaço do arquivo, parando no primeiro erro.
+void lerPedaco(PedacoImportado& pedaco) {
+    const char* p = pedaco.inicio;
+    int linha = 0;
+    while (p < pedaco.fim) {
+        const char* quebra = static_cast<const char*>(std::memchr(p, '\n', pedaco.fim - p));
+        const char* fimLinha = quebra ? quebra : pedaco.fim;
+        ++linha;
+        if (fimLinha > p) {
+            try {
+                std::unique_ptr<Jogador> jogador(new Jogador());
+                jogador->preencher(p, fimLinha);
+                pedaco.jogadores.push_back(std::move(jogador));
+                pedaco.linhas.push_back(linha);
+            } catch (const std::exception& e) {
+                pedaco.linhaErro = linha;
+                pedaco.erro = e.what();
+                return;
+            }
+        }
+        p = quebra ? quebra + 1 : pedaco.fim;
+    }
+    pedaco.totalLinhas = linha;
+}
+
+/// Tamanho mínimo de um pedaço: arquivos pequenos não compensam a divisão.
+const std::size_t TAMANHO_MINIMO_PEDACO = 1 << 16;
+
+} // namespace
+
+/**
+ * @brief Importa dados de jogadores de um arquivo, lendo o arquivo mapeado em memória em paralelo
+ *
+ * O arquivo é dividido em pedaços terminados em '\n', lidos pelas threads do pool e pela thread que
+ * chama; os jogadores entram no cadastro na ordem do arquivo. O resultado e as mensagens de erro
+ * (com o número exato da linha) são os mesmos do import de uma thread.
+ * @param caminho Caminho do arquivo a ser lido
+ * @param pool Threads que dividem a leitura
+ * @throw std::runtime_error Se houver erro na leitura do arquivo ou se ele estiver mal formatado
+ */
+void Cadastro::import(const std::string& caminho, ThreadPool& pool) {
+    if (_diario >= 0) sincronizar(); // O diário em disco precisa estar completo antes de ser aplicado
+
+    int descritor = ::open(caminho.c_str(), O_RDONLY);
+    struct stat informacoes;
+    if (descritor < 0 || ::fstat(descritor, &informacoes) != 0 || informacoes.st_size == 0) {
+        // Arquivo ausente ou vazio: o import de uma thread já trata esses casos
+        if (descritor >= 0) ::close(descritor);
+        import(caminho);
+        return;
+    }
+    const std::size_t tamanho = static_cast<std::size_t>(informacoes.st_size);
+    void* mapa = ::mmap(nullptr, tamanho, PROT_READ, MAP_PRIVATE, descritor, 0);
+    ::close(descritor);
+    if (mapa == MAP_FAILED) {
+        throw std::runtime_error(std::string("Erro na importação: não foi possível mapear o arquivo ") + caminho);
+    }
+    ::madvise(mapa, tamanho, MADV_SEQUENTIAL);
+    const char* dados = static_cast<const char*>(mapa);
+
+    // Pedaços de pelo menos TAMANHO_MINIMO_PEDACO, alguns por thread para equilibrar a carga
+    std::size_t quantidade = std::min<std::size_t>(static_cast<std::size_t>(pool.getThreads() + 1) * 4,
+                                                   tamanho / TAMANHO_MINIMO_PEDACO + 1);
+    std::vector<PedacoImportado> pedacos(quantidade);
+    const char* inicio = dados;
+    for (std::size_t i = 0; i < quantidade; i++) {
+        const char* fim = dados + tamanho * (i + 1) / quantidade;
+        if (i + 1 < quantidade && fim > inicio) {
+            const char* quebra = static_cast<const char*>(std::memchr(fim - 1, '\n', dados + tamanho - (fim - 1)));
+            fim = quebra ? quebra + 1 : dados + tamanho;
+        }
+        if (fim < inicio) fim = inicio;
+        pedacos[i].inicio = inicio;
+        pedacos[i].fim = fim;
+        inicio = fim;
+    }
+
+    std::atomic<std::size_t> proximo(0);
+    auto trabalhar = [&pedacos, &proximo]() {
+        for (std::size_t i = proximo++; i < pedacos.size(); i = proximo++) lerPedaco(pedacos[i]);
+    };
+    std::vector<std::future<void>> futuros;
+    for (int i = 0; i < pool.getThreads(); i++) futuros.push_back(pool.enviar(trabalhar));
+    std::exception_ptr falha;
+    try {
+        trabalhar();
+    } catch (...) {
+        falha = std::current_exception();
+    }
+    // Espera todas as tarefas antes de repassar uma exceção: elas usam os pedaços e o mapa
+    for (std::future<void>& futuro : futuros) futuro.wait();
+    try {
+        for (std::future<void>& futuro : futuros) futuro.get();
+        if (falha) std::rethrow_exception(falha);
+    } catch (const std::exception& e) {
+        ::munmap(mapa, tamanho);
+        throw std::runtime_error(std::string("Erro na importação: ") + e.what());
+    }
+    ::munmap(mapa, tamanho);
+
+    try {
+        _jogadores.clear();
+        _indice.clear();
+        std::size_t total = 0;
+        for (const PedacoImportado& pedaco : pedacos) total += pedaco.jogadores.size();
+        _jogadores.reserve(total);
+        _indice.reserve(total);
+
+        // Junta na ordem do arquivo: o primeiro erro relatado é o mesmo da leitura linha a linha
+        int linhasAnteriores = 0;
+        for (PedacoImportado& pedaco : pedacos) {
+            for (std::size_t i = 0; i < pedaco.jogadores.size(); i++) {
+                if (check(*pedaco.jogadores[i])) {
+                    throw std::invalid_argument(
+                        std::string("Erro na linha ") + std::to_string(linhasAnteriores + pedaco.linhas[i]) +
+                        ": Apelido repetido: " + pedaco.jogadores[i]->getApelido()
+                    );
+                }
+                inserir(std::move(pedaco.jogadores[i]));
+            }
+            if (pedaco.linhaErro != 0) {
+                throw std::invalid_argument(
+                    std::string("Erro na linha ") + std::to_string(linhasAnteriores + pedaco.linhaErro) + ": " + pedaco.erro
+                );
+            }
+            linhasAnteriores += pedaco.totalLinhas;
+        }
+
+        aplicarDiario(caminho);
+        if (_verboso) std::cout << "Jogadores importados com sucesso." << std::endl;
+
+    } catch (const std::exception& e) {
+        _jogadores.clear();
+        _indice.clear();
+        throw std::runtime_error(std::string("Erro na importação: ") + e.what());
+    }
+}
+
+/**
+ * @brief Importa os jogadores de um arquivo no formato binário (cadastrobinario.hpp) e aplica o diário
+ *
+ * Cada jogador é copiado do arquivo mapeado em memória, sem interpretar texto. Ao contrário do import,
+ * um arquivo que não existe é um erro.
+ * @param caminho Caminho do arquivo a ser lido
+ * @throw std::runtime_error Se o arquivo não puder ser lido, for inválido ou repetir um apelido
+ */
+void Cadastro::importBinario(const std::string& caminho) {
+    if (_diario >= 0) sincronizar(); // O diário em disco precisa estar completo antes de ser aplicado
+    try {
+        _jogadores.clear();
+        _indice.clear();
+        CadastroBinario arquivo(caminho);
+        _jogadores.reserve(arquivo.tamanho());
+        _indice.reserve(arquivo.tamanho());
+        for (std::size_t i = 0; i < arquivo.tamanho(); i++) {
+            std::unique_ptr<Jogador> novo(new Jogador());
+            try {
+                arquivo.ler(i, *novo);
+                if (check(*novo)) {
+                    throw std::invalid_argument("Apelido repetido: " + novo->getApelido());
+                }
+            } catch (const std::exception& e) {
+                throw std::invalid_argument(
+                    std::string("Erro no registro ") + std::to_string(i + 1) + ": " + e.what()
+                );
+            }
+            inserir(std::move(novo));
+        }
+        aplicarDiario(caminho);
+        if (_verboso) std::cout << "Jogadores importados com sucesso." << std::endl;
+
+    } catch (const std::exception& e) {
+        _jogadores.clear();
+        _indice.clear();
         throw std::runtime_error(std::string("Erro na importação: ") + e.what());
     }
 }
 
 /**
  * @brief Salva todos os jogadores em um arquivo
+ *
+ * Os dados vão para "<caminho>.tmp", que é sincronizado com o disco e renomeado por cima do arquivo:
+ * quem lê o arquivo vê a versão anterior inteira ou a nova inteira. Depois o diário é esvaziado.
  * @param caminho Caminho do arquivo onde os dados serão salvos
  * @throw std::runtime_error Se houver erro na escrita do arquivo
  */
 void Cadastro::save(const std::string& caminho) {
-    std::ofstream arquivo(caminho);
-    if (!arquivo.is_open()) {
+    gravar(caminho, false);
+}
 
+/**
+ * @brief Salva todos os jogadores em um arquivo no formato binário (cadastrobinario.hpp), com a
+ *        mesma gravação atômica e o mesmo tratamento do diário do save
+ * @param caminho Caminho do arquivo onde os dados serão salvos
+ * @throw std::runtime_error Se houver erro na escrita do arquivo
+ */
+void Cadastro::saveBinario(const std::string& caminho) {
+    gravar(caminho, true);
+}
+
+void Cadastro::gravar(const std::string& caminho, bool binario) {
+    const std::string temporario = caminho + ".tmp";
+    std::FILE* arquivo = std::fopen(temporario.c_str(), binario ? "wb" : "w");
+    if (!arquivo) {
         throw std::runtime_error(std::string("Não foi possível abrir o arquivo para escrita: ") + caminho);
     }
 
     try {
-        for (const auto& jogador : _jogadores) {
-            if (!jogador) {
-                throw std::runtime_error("Ponteiro inválido encontrado na lista de jogadores");
-            }
-            arquivo << jogador->serializar() << "\n";
-            if (arquivo.fail()) {
+        if (binario) {
+            std::string conteudo = CadastroBinario::codificar(_jogadores);
+            if (std::fwrite(conteudo.data(), 1, conteudo.size(), arquivo) != conteudo.size()) {
                 throw std::runtime_error("Falha ao escrever no arquivo");
             }
+        } else {
+            std::string linha;
+            for (const auto& jogador : _jogadores) {
+                if (!jogador) {
+                    throw std::runtime_error("Ponteiro inválido encontrado na lista de jogadores");
+                }
+                linha = jogador->serializar();
+                linha += '\n';
+                if (std::fwrite(linha.data(), 1, linha.size(), arquivo) != linha.size()) {
+                    throw std::runtime_error("Falha ao escrever no arquivo");
+                }
+            }
         }
-
-        arquivo.close();
-        std::cout << "Jogadores salvos com sucesso" << std::endl;
+        if (std::fflush(arquivo) != 0 || ::fsync(fileno(arquivo)) != 0) {
+            throw std::runtime_error("Falha ao sincronizar o arquivo com o disco");
+        }
+        std::FILE* fechado = arquivo;
+        arquivo = nullptr;
+        if (std::fclose(fechado) != 0) {
+            throw std::runtime_error("Falha ao fechar o arquivo");
+        }
+        if (std::rename(temporario.c_str(), caminho.c_str()) != 0) {
+            throw std::runtime_error("Falha ao substituir o arquivo");
+        }
+        sincronizarDiretorio(caminho);
+
+        // O arquivo principal já contém o que estava no diário
+        if (caminho == _caminho && _diario >= 0) {
+            std::lock_guard<std::mutex> arquivoDiario(_mutexArquivo);
+            std::lock_guard<std::mutex> pendente(_mutexPendente);
+            _pendente.clear();
+            if (::ftruncate(_diario, 0) != 0 || ::fsync(_diario) != 0) {
+                throw std::runtime_error("Falha ao esvaziar o diário");
+            }
+        } else {
+            std::remove(caminhoDiario(caminho).c_str());
+        }
+        _registrosDiario = 0;
+        if (_verboso) std::cout << "Jogadores salvos com sucesso" << std::endl;
 
     } catch (const std::exception& e) {
-        arquivo.close();
+        if (arquivo) std::fclose(arquivo);
+        std::remove(temporario.c_str());
         throw std::runtime_error(std::string("Erro ao salvar jogadores: ") + e.what());
     }
 }
@@ -238,18 +601,14 @@ void Cadastro::save(const std::string& caminho) {
  */
 void Cadastro::removeJogador(const Jogador& alvo) {
     try {
-        auto it = std::remove_if(_jogadores.begin(), _jogadores.end(),
-            [&alvo](const std::unique_ptr<Jogador>& jogador) -> bool {
-                return jogador && jogador->getApelido() == alvo.getApelido();
-            }
-        );
-
-        if (it == _jogadores.end()) {
+        auto it = _indice.find(alvo.getApelido());
+        if (it == _indice.end()) {
             throw std::invalid_argument(std::string("Jogador '") + alvo.getApelido() + "' não encontrado");
         }
 
-        _jogadores.erase(it, _jogadores.end());
-        std::cout << "Jogador " << alvo.getApelido() << " removido com sucesso" << std::endl;
+        retirar(it->second);
+        registrar('-', alvo.getApelido());
+        if (_verboso) std::cout << "Jogador " << alvo.getApelido() << " removido com sucesso" << std::endl;
 
     } catch (const std::invalid_argument& e) {
         throw;
@@ -262,20 +621,254 @@ void Cadastro::removeJogador(const Jogador& alvo) {
  * @brief Verifica se um jogador está cadastrado
  * @param alvo Jogador a ser verificado
  * @return true se o jogador estiver cadastrado, false caso contrário
- * @throw std::runtime_error Se houver erro durante a verificação
  */
 bool Cadastro::check(const Jogador& alvo) const {
-    try {
-        for (const auto& jogador : _jogadores) {
-            if (!jogador) {
-                throw std::runtime_error("Ponteiro inválido encontrado na lista de jogadores");
+    return _indice.find(alvo.getApelido()) != _indice.end();
+}
+
+/**
+ * @brief Procura um jogador pelo apelido
+ * @param apelido Apelido do jogador
+ * @return Ponteiro para o jogador cadastrado, ou nullptr se não houver jogador com esse apelido
+ */
+Jogador* Cadastro::find(const std::string& apelido) const {
+    auto it = _indice.find(apelido);
+    return it != _indice.end() ? _jogadores[it->second].get() : nullptr;
+}
+
+/**
+ * @brief Aplica ao cadastro os registros do diário de um arquivo principal, se houver
+ *
+ * Cada registro traz o estado final do jogador (e não a diferença), então aplicar um diário que
+ * o arquivo principal já contém (uma compactação interrompida antes de esvaziar o diário) não muda
+ * o resultado. Uma última linha sem '\n' é uma escrita interrompida e é ignorada.
+ * @throw std::invalid_argument Se algum registro estiver mal formatado
+ */
+void Cadastro::aplicarDiario(const std::string& caminho) {
+    std::ifstream diario(caminhoDiario(caminho));
+    _registrosDiario = 0;
+    if (!diario.is_open()) return;
+
+    std::string linha, apelido;
+    Jogador jogador;
+    int lineNumber = 0;
+    while (std::getline(diario, linha)) {
+        ++lineNumber;
+        if (diario.eof()) break; // Registro incompleto
+        if (linha.empty()) continue;
+        try {
+            if (linha.size() < 3 || linha[1] != ',') {
+                throw std::invalid_argument("Registro desconhecido");
             }
-            if (jogador->getApelido() == alvo.getApelido()) {
-                return true;
+            if (linha[0] == '-') {
+                apelido.assign(linha, 2, std::string::npos);
+                auto it = _indice.find(apelido);
+                if (it != _indice.end()) retirar(it->second);
+            } else if (linha[0] == '+' || linha[0] == '=') {
+                jogador.preencher(linha.data() + 2, linha.data() + linha.size());
+                Jogador* atual = find(jogador.getApelido());
+                if (atual) {
+                    *atual = jogador;
+                } else {
+                    inserir(std::unique_ptr<Jogador>(new Jogador(jogador)));
+                }
+            } else {
+                throw std::invalid_argument("Registro desconhecido");
             }
+        } catch (const std::exception& e) {
+            throw std::invalid_argument(
+                std::string("Erro no diário, linha ") + std::to_string(lineNumber) + ": " + e.what()
+            );
+        }
+        ++_registrosDiario;
+    }
+}
+
+/**
+ * @brief Acrescenta um registro ao diário aberto e compacta quando ele fica grande
+ *
+ * Sem intervalo de sincronização, o registro está no disco quando a função retorna; com intervalo,
+ * ele espera a próxima sincronização em grupo.
+ * @throw std::runtime_error Se houver erro na escrita do diário
+ */
+void Cadastro::registrar(char tipo, const std::string& conteudo) {
+    if (_diario < 0) return;
+    bool imediato;
+    {
+        std::lock_guard<std::mutex> trava(_mutexPendente);
+        if (!_erroDiario.empty()) {
+            throw std::runtime_error(_erroDiario);
+        }
+        _pendente += tipo;
+        _pendente += ',';
+        _pendente += conteudo;
+        _pendente += '\n';
+        imediato = _intervalo.count() == 0;
+    }
+    if (imediato) {
+        gravarPendentes();
+    } else {
+        if (!_sincronizador.joinable()) {
+            _sincronizador = std::thread(&Cadastro::executarSincronizador, this);
         }
-        return false;
+        _sinal.notify_one();
+    }
+
+    // Compactar só depois de tantos registros quanto jogadores deixa o custo por alteração constante
+    if (++_registrosDiario > std::max(MIN_REGISTROS_DIARIO, _jogadores.size())) compactar();
+}
+
+/**
+ * @brief Grava os registros pendentes no diário e sincroniza com o disco, com um único fsync
+ * @throw std::runtime_error Se houver erro na escrita
+ */
+void Cadastro::gravarPendentes() {
+    // A trava do arquivo mantém a ordem dos grupos; a dos pendentes fica livre durante o fsync
+    std::lock_guard<std::mutex> arquivo(_mutexArquivo);
+    std::string grupo;
+    {
+        std::lock_guard<std::mutex> trava(_mutexPendente);
+        grupo.swap(_pendente);
+    }
+    if (grupo.empty() || _diario < 0) return;
+
+    std::size_t escrito = 0;
+    while (escrito < grupo.size()) {
+        ssize_t n = ::write(_diario, grupo.data() + escrito, grupo.size() - escrito);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Falha ao escrever no diário: " + caminhoDiario(_caminho));
+        }
+        escrito += static_cast<std::size_t>(n);
+    }
+    if (::fdatasync(_diario) != 0) {
+        throw std::runtime_error("Falha ao sincronizar o diário: " + caminhoDiario(_caminho));
+    }
+    ++_sincronizacoes;
+}
+
+/**
+ * @brief Laço da thread de sincronização: espera o primeiro registro pendente, junta os que chegarem
+ *        durante o intervalo e grava o grupo
+ */
+void Cadastro::executarSincronizador() {
+    std::unique_lock<std::mutex> trava(_mutexPendente);
+    while (true) {
+        _sinal.wait(trava, [this] { return _parar || (!_pendente.empty() && _erroDiario.empty()); });
+        if (_parar) return;
+        _sinal.wait_for(trava, _intervalo, [this] { return _parar; });
+        trava.unlock();
+        try {
+            gravarPendentes();
+            trava.lock();
+        } catch (const std::exception& e) {
+            trava.lock();
+            _erroDiario = e.what();
+        }
+    }
+}
+
+/**
+ * @brief Grava e sincroniza agora os registros pendentes do diário
+ * @throw std::runtime_error Se houver erro na escrita ou se uma sincronização anterior tiver falhado
+ */
+void Cadastro::sincronizar() {
+    {
+        std::lock_guard<std::mutex> trava(_mutexPendente);
+        if (!_erroDiario.empty()) {
+            throw std::runtime_error(_erroDiario);
+        }
+    }
+    gravarPendentes();
+}
+
+/**
+ * @brief Define o intervalo da sincronização em grupo do diário
+ * @param intervalo Tempo máximo que um registro espera para ir ao disco (0 = sincroniza cada registro)
+ */
+void Cadastro::setIntervaloSincronizacao(std::chrono::milliseconds intervalo) {
+    std::lock_guard<std::mutex> trava(_mutexPendente);
+    _intervalo = intervalo;
+}
+
+/**
+ * @brief Para a thread de sincronização, grava o que estiver pendente e fecha o diário
+ * @throw std::runtime_error Se a gravação dos registros pendentes falhar
+ */
+void Cadastro::fecharDiario() {
+    if (_sincronizador.joinable()) {
+        {
+            std::lock_guard<std::mutex> trava(_mutexPendente);
+            _parar = true;
+        }
+        _sinal.notify_one();
+        _sincronizador.join();
+        _parar = false;
+    }
+    if (_diario >= 0) {
+        int descritor = _diario;
+        try {
+            gravarPendentes();
+        } catch (...) {
+            ::close(descritor);
+            _diario = -1;
+            throw;
+        }
+        ::close(descritor);
+        _diario = -1;
+    }
+}
+
+Cadastro::~Cadastro() {
+    try {
+        fecharDiario();
     } catch (const std::exception& e) {
-        throw std::runtime_error(std::string("Erro ao verificar jogador: ") + e.what());
+        std::cerr << "Erro ao fechar o diário do cadastro: " << e.what() << std::endl;
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Passa a registrar as alterações no diário do arquivo principal dado
+ *
+ * Um registro incompleto no fim do diário é cortado antes dos novos registros.
+ * @param caminho Arquivo principal do cadastro (o diário é "<caminho>.diario")
+ * @throw std::runtime_error Se não for possível abrir o diário ou cortar o registro incompleto
+ */
+void Cadastro::abrirDiario(const std::string& caminho) {
+    fecharDiario();
+    _erroDiario.clear();
+    _caminho = caminho;
+    _diario = ::open(caminhoDiario(caminho).c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (_diario < 0) {
+        _caminho.clear();
+        throw std::runtime_error("Não foi possível abrir o diário: " + caminhoDiario(caminho));
+    }
+    // Um registro incompleto no fim (queda no meio da gravação) é ignorado pelo import; se ficasse,
+    // o próximo registro seria colado nele e o diário não poderia mais ser lido
+    off_t tamanho = ::lseek(_diario, 0, SEEK_END);
+    off_t completo = fimDoUltimoRegistro(_diario, tamanho);
+    if (completo < 0 || (completo < tamanho && (::ftruncate(_diario, completo) != 0 || ::fsync(_diario) != 0))) {
+        fecharDiario();
+        _caminho.clear();
+        throw std::runtime_error("Não foi possível descartar o registro incompleto do diário: " + caminhoDiario(caminho));
+    }
+}
+
+/**
+ * @brief Registra no diário o placar atual de um jogador, depois de uma partida
+ * @param jogador Jogador cadastrado cujo placar foi alterado
+ */
+void Cadastro::registrarAlteracao(const Jogador& jogador) {
+    registrar('=', jogador.serializar());
+}
+
+/**
+ * @brief Grava o arquivo principal do diário aberto, o que esvazia o diário
+ * @throw std::runtime_error Se não houver diário aberto ou se a gravação falhar
+ */
+void Cadastro::compactar() {
+    if (_caminho.empty()) {
+        throw std::runtime_error("Nenhum diário aberto para compactar");
+    }
+    save(_caminho);
+}
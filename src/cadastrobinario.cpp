@@ -0,0 +1,255 @@
+/**
+ * @file cadastrobinario.cpp
+ * @brief Declaração dos métodos da classe CadastroBinario.
+ */
+
+#include "cadastrobinario.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const std::uint32_t CadastroBinario::VERSAO;
+const std::size_t CadastroBinario::TAMANHO_CABECALHO;
+const std::size_t CadastroBinario::TAMANHO_REGISTRO;
+
+namespace {
+
+const char ASSINATURA[4] = {'C', 'A', 'D', 'B'};
+
+std::uint32_t lerU32(const unsigned char* p) {
+    return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) |
+           (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+void escreverU32(std::string& saida, std::uint32_t valor) {
+    char bytes[4] = {static_cast<char>(valor & 0xff), static_cast<char>((valor >> 8) & 0xff),
+                     static_cast<char>((valor >> 16) & 0xff), static_cast<char>((valor >> 24) & 0xff)};
+    saida.append(bytes, 4);
+}
+
+/// Converte um tamanho ou placar para 32 bits, recusando o que não cabe.
+std::uint32_t paraU32(long long valor, const char* campo) {
+    if (valor < 0 || valor > static_cast<long long>(UINT32_MAX)) {
+        throw std::runtime_error(std::string(campo) + " fora do intervalo do formato binário");
+    }
+    return static_cast<std::uint32_t>(valor);
+}
+
+/// Placar guardado no registro, que precisa caber em um int.
+int lerPlacar(const unsigned char* p) {
+    std::uint32_t valor = lerU32(p);
+    if (valor > static_cast<std::uint32_t>(INT_MAX)) {
+        throw std::runtime_error("Placar inválido no arquivo binário");
+    }
+    return static_cast<int>(valor);
+}
+
+/// Compara o texto [dados, dados + tamanho) com o apelido, como std::string::compare.
+int comparar(const char* dados, std::size_t tamanho, const std::string& apelido) {
+    int resultado = std::memcmp(dados, apelido.data(), std::min(tamanho, apelido.size()));
+    if (resultado != 0) return resultado;
+    return tamanho < apelido.size() ? -1 : (tamanho > apelido.size() ? 1 : 0);
+}
+
+} // namespace
+
+/**
+ * @brief Mapeia o arquivo em memória e confere o cabeçalho
+ * @param caminho Caminho do arquivo binário
+ * @throw std::runtime_error Se o arquivo não puder ser aberto ou o cabeçalho for inválido
+ */
+CadastroBinario::CadastroBinario(const std::string& caminho) {
+    int descritor = ::open(caminho.c_str(), O_RDONLY);
+    if (descritor < 0) {
+        throw std::runtime_error("Não foi possível abrir o arquivo: " + caminho);
+    }
+    struct stat informacoes;
+    if (::fstat(descritor, &informacoes) != 0 ||
+        static_cast<std::size_t>(informacoes.st_size) < TAMANHO_CABECALHO) {
+        ::close(descritor);
+        throw std::runtime_error("Arquivo binário de cadastro inválido: " + caminho);
+    }
+    _tamanhoArquivo = static_cast<std::size_t>(informacoes.st_size);
+    void* mapa = ::mmap(nullptr, _tamanhoArquivo, PROT_READ, MAP_PRIVATE, descritor, 0);
+    ::close(descritor); // O mapeamento continua válido sem o descritor
+    if (mapa == MAP_FAILED) {
+        throw std::runtime_error("Não foi possível mapear o arquivo: " + caminho);
+    }
+    _dados = static_cast<const unsigned char*>(mapa);
+
+    // Tamanhos em 64 bits: somas de campos de 32 bits não transbordam
+    const unsigned char* cabecalho = _dados;
+    std::uint64_t quantidade = lerU32(cabecalho + 8);
+    std::uint64_t tamanhoRegistro = lerU32(cabecalho + 12);
+    std::uint64_t inicioRegistros = lerU32(cabecalho + 16);
+    std::uint64_t inicioIndice = lerU32(cabecalho + 20);
+    std::uint64_t inicioTextos = lerU32(cabecalho + 24);
+    std::uint64_t tamanhoTextos = lerU32(cabecalho + 28);
+    const char* erro = nullptr;
+    if (std::memcmp(cabecalho, ASSINATURA, sizeof(ASSINATURA)) != 0) {
+        erro = "assinatura desconhecida";
+    } else if (lerU32(cabecalho + 4) != VERSAO) {
+        erro = "versão não suportada";
+    } else if (tamanhoRegistro < TAMANHO_REGISTRO || inicioRegistros + quantidade * tamanhoRegistro > _tamanhoArquivo ||
+               inicioIndice + quantidade * 4 > _tamanhoArquivo || inicioTextos + tamanhoTextos > _tamanhoArquivo) {
+        erro = "seções fora do arquivo";
+    }
+    if (erro) {
+        ::munmap(mapa, _tamanhoArquivo);
+        throw std::runtime_error("Arquivo binário de cadastro inválido (" + std::string(erro) + "): " + caminho);
+    }
+    _quantidade = static_cast<std::size_t>(quantidade);
+    _tamanhoRegistro = static_cast<std::size_t>(tamanhoRegistro);
+    _registros = _dados + inicioRegistros;
+    _indice = _dados + inicioIndice;
+    _textos = _dados + inicioTextos;
+    _tamanhoTextos = static_cast<std::size_t>(tamanhoTextos);
+}
+
+CadastroBinario::~CadastroBinario() {
+    ::munmap(const_cast<unsigned char*>(_dados), _tamanhoArquivo);
+}
+
+const unsigned char* CadastroBinario::registro(std::size_t posicao) const {
+    if (posicao >= _quantidade) {
+        throw std::out_of_range("Posição fora do cadastro binário: " + std::to_string(posicao));
+    }
+    return _registros + posicao * _tamanhoRegistro;
+}
+
+const char* CadastroBinario::texto(const unsigned char* campo, std::size_t& tamanho) const {
+    std::uint64_t inicio = lerU32(campo);
+    tamanho = lerU32(campo + 4);
+    if (inicio + tamanho > _tamanhoTextos) {
+        throw std::runtime_error("Texto fora do arquivo binário de cadastro");
+    }
+    return reinterpret_cast<const char*>(_textos + inicio);
+}
+
+/**
+ * @brief Lê um jogador do arquivo sem interpretar texto
+ * @param posicao Posição do jogador, na ordem do cadastro
+ * @param jogador Recebe o nome, o apelido e os placares
+ * @throw std::out_of_range Se a posição não existir
+ * @throw std::runtime_error Se o registro for inválido; o jogador não muda
+ */
+void CadastroBinario::ler(std::size_t posicao, Jogador& jogador) const {
+    const unsigned char* r = registro(posicao);
+    std::size_t tamanhoNome, tamanhoApelido;
+    const char* nome = texto(r, tamanhoNome);
+    const char* apelido = texto(r + 8, tamanhoApelido);
+    int placares[6];
+    for (int i = 0; i < 6; i++) placares[i] = lerPlacar(r + 16 + 4 * i);
+
+    jogador.setNome(nome, tamanhoNome);
+    jogador.setApelido(apelido, tamanhoApelido);
+    jogador.setVitorias(jogador.getVelha(), placares[0]);
+    jogador.setDerrotas(jogador.getVelha(), placares[1]);
+    jogador.setVitorias(jogador.getLig4(), placares[2]);
+    jogador.setDerrotas(jogador.getLig4(), placares[3]);
+    jogador.setVitorias(jogador.getReversi(), placares[4]);
+    jogador.setDerrotas(jogador.getReversi(), placares[5]);
+}
+
+Jogador CadastroBinario::jogador(std::size_t posicao) const {
+    Jogador jogador;
+    ler(posicao, jogador);
+    return jogador;
+}
+
+/**
+ * @brief Procura um jogador pelo apelido
+ * @param apelido Apelido procurado
+ * @return Posição do jogador na ordem do cadastro, ou -1 se não estiver no arquivo
+ */
+long CadastroBinario::procurar(const std::string& apelido) const {
+    std::size_t inicio = 0, fim = _quantidade;
+    while (inicio < fim) {
+        std::size_t meio = inicio + (fim - inicio) / 2;
+        std::size_t posicao = lerU32(_indice + 4 * meio);
+        std::size_t tamanho;
+        const char* candidato = texto(registro(posicao) + 8, tamanho);
+        int resultado = comparar(candidato, tamanho, apelido);
+        if (resultado == 0) return static_cast<long>(posicao);
+        if (resultado < 0) {
+            inicio = meio + 1;
+        } else {
+            fim = meio;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Codifica os jogadores no formato binário
+ * @param jogadores Jogadores na ordem em que vão para o arquivo
+ * @return Conteúdo completo do arquivo
+ * @throw std::runtime_error Se algum placar for negativo ou algum tamanho não couber em 32 bits
+ */
+std::string CadastroBinario::codificar(const std::vector<std::unique_ptr<Jogador>>& jogadores) {
+    std::uint32_t quantidade = paraU32(static_cast<long long>(jogadores.size()), "Quantidade de jogadores");
+    std::size_t inicioRegistros = TAMANHO_CABECALHO;
+    std::size_t inicioIndice = inicioRegistros + jogadores.size() * TAMANHO_REGISTRO;
+    std::size_t inicioTextos = inicioIndice + jogadores.size() * 4;
+
+    std::string registros, textos;
+    registros.reserve(jogadores.size() * TAMANHO_REGISTRO);
+    for (const auto& jogador : jogadores) {
+        if (!jogador) {
+            throw std::runtime_error("Ponteiro inválido encontrado na lista de jogadores");
+        }
+        // getNome e getApelido devolvem cópias: cada uma é lida uma vez só
+        std::string nome = jogador->getNome(), apelido = jogador->getApelido();
+        escreverU32(registros, paraU32(static_cast<long long>(textos.size()), "Área de textos"));
+        escreverU32(registros, paraU32(static_cast<long long>(nome.size()), "Nome"));
+        textos += nome;
+        escreverU32(registros, paraU32(static_cast<long long>(textos.size()), "Área de textos"));
+        escreverU32(registros, paraU32(static_cast<long long>(apelido.size()), "Apelido"));
+        textos += apelido;
+        Winrate* jogos[3] = {&jogador->getVelha(), &jogador->getLig4(), &jogador->getReversi()};
+        for (Winrate* jogo : jogos) {
+            escreverU32(registros, paraU32(jogo->_vitorias, "Placar"));
+            escreverU32(registros, paraU32(jogo->_derrotas, "Placar"));
+        }
+    }
+
+    std::vector<std::uint32_t> ordem(jogadores.size());
+    for (std::uint32_t i = 0; i < quantidade; i++) ordem[i] = i;
+    auto apelido = [&](std::uint32_t i) {
+        const unsigned char* r = reinterpret_cast<const unsigned char*>(registros.data()) + i * TAMANHO_REGISTRO;
+        return std::make_pair(textos.data() + lerU32(r + 8), static_cast<std::size_t>(lerU32(r + 12)));
+    };
+    std::sort(ordem.begin(), ordem.end(), [&](std::uint32_t a, std::uint32_t b) {
+        std::pair<const char*, std::size_t> x = apelido(a), y = apelido(b);
+        int resultado = std::memcmp(x.first, y.first, std::min(x.second, y.second));
+        return resultado != 0 ? resultado < 0 : x.second < y.second;
+    });
+
+    std::string saida;
+    saida.reserve(inicioTextos + textos.size());
+    saida.append(ASSINATURA, sizeof(ASSINATURA));
+    escreverU32(saida, VERSAO);
+    escreverU32(saida, quantidade);
+    escreverU32(saida, TAMANHO_REGISTRO);
+    escreverU32(saida, paraU32(static_cast<long long>(inicioRegistros), "Arquivo"));
+    escreverU32(saida, paraU32(static_cast<long long>(inicioIndice), "Arquivo"));
+    escreverU32(saida, paraU32(static_cast<long long>(inicioTextos), "Arquivo"));
+    escreverU32(saida, paraU32(static_cast<long long>(textos.size()), "Área de textos"));
+    saida += registros;
+    for (std::uint32_t posicao : ordem) escreverU32(saida, posicao);
+    saida += textos;
+    paraU32(static_cast<long long>(saida.size()), "Arquivo");
+    return saida;
+}
+
+bool CadastroBinario::reconhecer(const std::string& caminho) {
+    std::ifstream arquivo(caminho, std::ios::binary);
+    char inicio[sizeof(ASSINATURA)];
+    return arquivo.read(inicio, sizeof(inicio)) && std::memcmp(inicio, ASSINATURA, sizeof(ASSINATURA)) == 0;
+}
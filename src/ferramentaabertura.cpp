@@ -0,0 +1,68 @@
+/**
+ * @file ferramentaabertura.cpp
+ * @brief Ferramenta de linha de comando da tabela de abertura do Lig4 (alvo "make abertura"): gera o
+ *        arquivo lido pelo modo perfeito do Lig4Bot (nível 4 da Partida e bot "perfeito" da arena).
+ *
+ * Uso: abertura <jogadas> [--saida arquivo] [--tabela MB]
+ *  - Resolve todas as posições 7x6 com até "jogadas" peças e grava a tabela (padrão:
+ *    "abertura_lig4.txt", o arquivo procurado pela Partida). Com a tabela, as jogadas das posições
+ *    com menos de "jogadas" peças saem sem busca.
+ *  - O custo cresce depressa com "jogadas" (as posições mais profundas são as caras): comece por
+ *    valores pequenos. O progresso de cada nível vai para a saída de erro.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+#include "solucionadorlig4.hpp"
+#include "transposicao.hpp"
+
+namespace {
+
+typedef std::chrono::steady_clock Relogio;
+
+int uso() {
+    std::fprintf(stderr, "Uso: abertura <jogadas> [--saida arquivo] [--tabela MB]\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) return uso();
+    int jogadas = std::atoi(argv[1]);
+    if (jogadas < 0 || jogadas > SolucionadorLig4::LARGURA * SolucionadorLig4::ALTURA) return uso();
+    std::string saida = "abertura_lig4.txt";
+    std::size_t megabytes = 256;
+    for (int i = 2; i < argc; i++) {
+        if (std::strcmp(argv[i], "--saida") == 0 && i + 1 < argc) {
+            saida = argv[++i];
+        } else if (std::strcmp(argv[i], "--tabela") == 0 && i + 1 < argc) {
+            megabytes = static_cast<std::size_t>(std::atoi(argv[++i]));
+        } else {
+            return uso();
+        }
+    }
+
+    try {
+        TabelaTransposicao tabela(megabytes);
+        ContextoBusca contexto;
+        contexto.tabela = &tabela;
+        SolucionadorLig4 solucionador;
+        Relogio::time_point inicio = Relogio::now();
+        solucionador.gravarAbertura(saida, jogadas, contexto, [&inicio](int nivel, std::size_t posicoes) {
+            double segundos = std::chrono::duration<double>(Relogio::now() - inicio).count();
+            std::fprintf(stderr, "[%.1f s] %d peças: %zu posições\n", segundos, nivel, posicoes);
+        });
+        double segundos = std::chrono::duration<double>(Relogio::now() - inicio).count();
+        std::printf("{\"arquivo\":\"%s\",\"jogadas\":%d,\"posicoes\":%zu,\"nos\":%lld,\"segundos\":%.1f}\n",
+                    saida.c_str(), jogadas, solucionador.getTamanhoAbertura(), contexto.nos, segundos);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "Erro: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
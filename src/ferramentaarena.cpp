@@ -0,0 +1,89 @@
+/**
+ * @file ferramentaarena.cpp
+ * @brief Ferramenta de linha de comando da arena (alvo "make arena"): partidas bot contra bot em todas
+ *        as threads, para comparar a força de duas configurações de bot.
+ *
+ * Uso: arena <velha|lig4|reversi> --a BOT --b BOT [--partidas N] [--threads N] [--semente S]
+ *            [--abertura P] [--tamanho LxC] [--k K]
+ *  - BOT: "alfabeta:profundidade", "mcts:simulações" (Reversi) ou "perfeito" (Lig4 7x6, Velha 3x3).
+ *  - --tamanho: no Reversi, só tabuleiros quadrados (LxL).
+ *  - Imprime uma linha JSON com o placar do bot A, a pontuação, a diferença de Elo (A - B) com a
+ *    margem de 95% e a vazão em partidas por segundo.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <thread>
+#include "arena.hpp"
+
+namespace {
+
+int uso() {
+    std::fprintf(stderr, "Uso: arena <velha|lig4|reversi> --a BOT --b BOT [--partidas N] [--threads N] "
+                         "[--semente S] [--abertura P] [--tamanho LxC] [--k K]\n"
+                         "BOT: alfabeta:profundidade, mcts:simulacoes ou perfeito\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) return uso();
+    std::string jogo = argv[1];
+    ConfiguracaoArena configuracao;
+    if (jogo == "velha") {
+        configuracao.tipoJogo = 1;
+    } else if (jogo == "lig4") {
+        configuracao.tipoJogo = 2;
+    } else if (jogo == "reversi") {
+        configuracao.tipoJogo = 3;
+    } else {
+        return uso();
+    }
+    unsigned nucleos = std::thread::hardware_concurrency();
+    configuracao.threads = nucleos > 0 ? static_cast<int>(nucleos) : 1;
+
+    try {
+        for (int i = 2; i < argc; i++) {
+            if (i + 1 >= argc) return uso();
+            const char* opcao = argv[i];
+            const char* valor = argv[++i];
+            if (std::strcmp(opcao, "--a") == 0) {
+                configuracao.bots[0] = ConfiguracaoBot::ler(valor);
+            } else if (std::strcmp(opcao, "--b") == 0) {
+                configuracao.bots[1] = ConfiguracaoBot::ler(valor);
+            } else if (std::strcmp(opcao, "--partidas") == 0) {
+                configuracao.partidas = std::atoi(valor);
+            } else if (std::strcmp(opcao, "--threads") == 0) {
+                configuracao.threads = std::atoi(valor);
+            } else if (std::strcmp(opcao, "--semente") == 0) {
+                configuracao.semente = static_cast<unsigned>(std::strtoul(valor, nullptr, 10));
+            } else if (std::strcmp(opcao, "--abertura") == 0) {
+                configuracao.aberturaAleatoria = std::atoi(valor);
+            } else if (std::strcmp(opcao, "--tamanho") == 0) {
+                if (std::sscanf(valor, "%dx%d", &configuracao.linhas, &configuracao.colunas) != 2) return uso();
+            } else if (std::strcmp(opcao, "--k") == 0) {
+                configuracao.k = std::atoi(valor);
+            } else {
+                return uso();
+            }
+        }
+
+        Arena arena(configuracao);
+        ResultadoArena resultado = arena.executar();
+        std::printf("{\"jogo\":\"%s\",\"a\":\"%s\",\"b\":\"%s\",\"partidas\":%d,\"threads\":%d,"
+                    "\"vitorias\":%d,\"empates\":%d,\"derrotas\":%d,\"pontuacao\":%.3f,"
+                    "\"elo\":%.1f,\"elo_erro\":%.1f,\"segundos\":%.2f,\"partidas_por_s\":%.2f}\n",
+                    jogo.c_str(), configuracao.bots[0].texto().c_str(), configuracao.bots[1].texto().c_str(),
+                    resultado.partidas(), configuracao.threads, resultado.vitorias, resultado.empates,
+                    resultado.derrotas, resultado.pontuacao(), resultado.elo(), resultado.erroElo(),
+                    resultado.segundos, resultado.partidasPorSegundo());
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "Erro: %s\n", e.what());
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,63 @@
+/**
+ * @file ferramentacadastro.cpp
+ * @brief Ferramenta de linha de comando do arquivo de cadastro (alvo "make cadastro"): converte entre
+ *        o formato texto e o binário e consulta um arquivo binário sem carregá-lo.
+ *
+ * Uso: cadastro convert <entrada> <saida>
+ *      cadastro procurar <arquivo binário> <apelido>
+ *  - convert: lê a entrada (com o seu diário, se houver) e grava a saída no outro formato; o formato
+ *    da entrada é reconhecido pela assinatura do arquivo binário.
+ *  - procurar: imprime o jogador com o apelido no formato texto, pelo índice do arquivo binário.
+ */
+
+#include <cstdio>
+#include <exception>
+#include <string>
+#include "cadastro.hpp"
+#include "cadastrobinario.hpp"
+
+namespace {
+
+int uso() {
+    std::fprintf(stderr, "Uso: cadastro convert <entrada> <saida>\n"
+                         "     cadastro procurar <arquivo binario> <apelido>\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc != 4) return uso();
+    std::string comando = argv[1];
+
+    try {
+        if (comando == "convert") {
+            Cadastro cadastro;
+            cadastro.setVerboso(false);
+            bool binario = CadastroBinario::reconhecer(argv[2]);
+            if (binario) {
+                cadastro.importBinario(argv[2]);
+                cadastro.save(argv[3]);
+            } else {
+                cadastro.import(argv[2]);
+                cadastro.saveBinario(argv[3]);
+            }
+            std::printf("%zu jogadores: %s (%s) -> %s (%s)\n", cadastro.get_jogadores().size(), argv[2],
+                        binario ? "binario" : "texto", argv[3], binario ? "texto" : "binario");
+        } else if (comando == "procurar") {
+            CadastroBinario arquivo(argv[2]);
+            long posicao = arquivo.procurar(argv[3]);
+            if (posicao < 0) {
+                std::fprintf(stderr, "Jogador não encontrado: %s\n", argv[3]);
+                return 1;
+            }
+            std::printf("%s\n", arquivo.jogador(static_cast<std::size_t>(posicao)).serializar().c_str());
+        } else {
+            return uso();
+        }
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "Erro: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file ferramentaperft.cpp
+ * @brief Ferramenta de linha de comando do perft (alvo "make perft"): vazão da geração de jogadas e
+ *        validação cruzada entre a implementação de referência e as otimizadas.
+ *
+ * Uso: perft <reversi|lig4> <profundidade> [--threads N] [--validar] [--tamanho LxC]
+ *  - Sem --validar, conta as folhas de 1 até a profundidade com a implementação mais rápida ("bits",
+ *    ou "tabuleiro" se o tamanho não couber em 64 bits), uma linha JSON por profundidade.
+ *  - Com --validar, conta cada profundidade com todas as implementações e falha (código 1) na primeira
+ *    divergência em relação à referência.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+#include "perft.hpp"
+#include "threadpool.hpp"
+
+namespace {
+
+typedef std::chrono::steady_clock Relogio;
+
+/**
+ * @brief Conta as folhas e imprime uma linha JSON com o tempo e a vazão.
+ * @param pool Threads para dividir a raiz (nullptr = uma thread).
+ */
+long long medir(ThreadPool* pool, const std::string& jogo, Perft::Implementacao implementacao,
+                int profundidade, int linhas, int colunas) {
+    Relogio::time_point inicio = Relogio::now();
+    long long folhas;
+    if (pool) {
+        folhas = Perft::paralelo(*pool, jogo, implementacao, profundidade, linhas, colunas);
+    } else if (jogo == "reversi") {
+        folhas = Perft::reversi(implementacao, profundidade, linhas);
+    } else {
+        folhas = Perft::lig4(implementacao, profundidade, linhas, colunas);
+    }
+    double segundos = std::chrono::duration<double>(Relogio::now() - inicio).count();
+    std::printf("{\"jogo\":\"%s\",\"implementacao\":\"%s\",\"threads\":%d,\"profundidade\":%d,"
+                "\"folhas\":%lld,\"ms\":%.1f,\"folhas_por_s\":%.0f}\n",
+                jogo.c_str(), Perft::nome(implementacao), pool ? pool->getThreads() : 1, profundidade,
+                folhas, segundos * 1000.0, segundos > 0 ? folhas / segundos : 0.0);
+    std::fflush(stdout);
+    return folhas;
+}
+
+int uso() {
+    std::fprintf(stderr, "Uso: perft <reversi|lig4> <profundidade> [--threads N] [--validar] [--tamanho LxC]\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) return uso();
+    std::string jogo = argv[1];
+    int profundidade = std::atoi(argv[2]);
+    int threads = 1;
+    bool validar = false;
+    int linhas = (jogo == "lig4") ? 6 : 8;
+    int colunas = (jogo == "lig4") ? 7 : 8;
+
+    for (int i = 3; i < argc; i++) {
+        if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--validar") == 0) {
+            validar = true;
+        } else if (std::strcmp(argv[i], "--tamanho") == 0 && i + 1 < argc) {
+            if (std::sscanf(argv[++i], "%dx%d", &linhas, &colunas) != 2) return uso();
+        } else {
+            return uso();
+        }
+    }
+    if ((jogo != "reversi" && jogo != "lig4") || profundidade < 0 || linhas <= 0 || colunas <= 0) return uso();
+    if (jogo == "reversi") colunas = linhas; // Reversi só em tabuleiros quadrados
+
+    // A thread que chama só espera: o pool recebe todas as threads pedidas
+    std::unique_ptr<ThreadPool> pool;
+    if (threads > 1) pool.reset(new ThreadPool(threads));
+
+    bool cabeEmBits = (jogo == "reversi") ? linhas == 8 : Lig4Bitboard::cabe(linhas, colunas);
+    std::vector<Perft::Implementacao> implementacoes;
+    if (validar) {
+        implementacoes.push_back(Perft::REFERENCIA);
+        implementacoes.push_back(Perft::TABULEIRO);
+    }
+    implementacoes.push_back(cabeEmBits ? Perft::BITS : Perft::TABULEIRO);
+    if (validar && !cabeEmBits) implementacoes.pop_back();
+
+    try {
+        for (int p = 1; p <= profundidade; p++) {
+            long long referencia = -1;
+            for (Perft::Implementacao implementacao : implementacoes) {
+                long long folhas = medir(pool.get(), jogo, implementacao, p, linhas, colunas);
+                if (referencia < 0) {
+                    referencia = folhas;
+                } else if (folhas != referencia) {
+                    std::printf("{\"divergencia\":true,\"profundidade\":%d,\"implementacao\":\"%s\","
+                                "\"folhas\":%lld,\"referencia\":%lld}\n",
+                                p, Perft::nome(implementacao), folhas, referencia);
+                    return 1;
+                }
+            }
+        }
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "Erro: %s\n", e.what());
+        return 2;
+    }
+    return 0;
+}
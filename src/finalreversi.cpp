@@ -0,0 +1,276 @@
+/**
+ * @file finalreversi.cpp
+ * @brief Declaração dos métodos da classe SolucionadorFinalReversi.
+ */
+
+#include "finalreversi.hpp"
+#include <algorithm>
+
+namespace {
+
+const int VAZIAS_PARA_MOBILIDADE = 7; // Abaixo disso, ordenar por mobilidade custa mais do que economiza
+const int VAZIAS_PARA_TABELA = 10;     // Abaixo disso, consultar a tabela custa mais do que refazer a busca
+
+const uint64_t QUADRANTES[4] = {
+    0x000000000f0f0f0fULL, 0x00000000f0f0f0f0ULL,
+    0x0f0f0f0f00000000ULL, 0xf0f0f0f000000000ULL
+};
+
+const uint64_t CANTOS = 0x8100000000000081ULL;
+
+inline int contar(uint64_t mascara) { return __builtin_popcountll(mascara); }
+
+inline uint64_t quadrante(int casa) {
+    return QUADRANTES[((casa >> 5) & 2) | ((casa >> 2) & 1)];
+}
+
+/// Chave da posição na tabela de transposição (o jogador da vez é sempre o dono de "proprias").
+inline uint64_t chave(uint64_t proprias, uint64_t oponente) {
+    uint64_t z = proprias * 0x9e3779b97f4a7c15ULL ^ (oponente + 0x632be59bd9b4e019ULL) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 31)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 29);
+}
+
+/// Diferença de peças numa posição final: as casas que sobrarem vazias não contam para ninguém.
+inline int diferenca(uint64_t proprias, uint64_t oponente) {
+    return contar(proprias) - contar(oponente);
+}
+
+} // namespace
+
+/**
+ * @brief Resolve a raiz, testando todas as jogadas com janela completa para escolher a melhor.
+ */
+int SolucionadorFinalReversi::resolver(uint64_t proprias, uint64_t oponente, int& melhorCasa) {
+    melhorCasa = -1;
+    uint64_t jogadas = ReversiBitboard::jogadas_validas(proprias, oponente);
+    if (jogadas == 0) {
+        return buscar(proprias, oponente, -64, 64, false);
+    }
+
+    int casas[64];
+    int total = ordenarJogadas(proprias, oponente, jogadas, casas);
+    int alfa = -65;
+    for (int i = 0; i < total && !contexto_.abortada; i++) {
+        uint64_t viradas = ReversiBitboard::calcular_viradas(casas[i], proprias, oponente);
+        uint64_t depois = proprias | viradas | (1ULL << casas[i]);
+        int valor = -buscar(oponente & ~viradas, depois, -64, -alfa, false);
+        if (!contexto_.abortada && valor > alfa) {
+            alfa = valor;
+            melhorCasa = casas[i];
+        }
+    }
+    return alfa;
+}
+
+/**
+ * @brief Alfa-beta até o fim do jogo; com 4 casas vazias ou menos passa às rotinas especializadas.
+ * @param passou true se o oponente acabou de passar a vez (dois passes seguidos encerram o jogo).
+ */
+int SolucionadorFinalReversi::buscar(uint64_t proprias, uint64_t oponente, int alfa, int beta, bool passou) {
+    contexto_.nos++;
+    if (contexto_.deveParar()) {
+        return 0;
+    }
+
+    uint64_t vazias = ~(proprias | oponente);
+    int totalVazias = contar(vazias);
+    if (totalVazias <= 4) {
+        int x[4];
+        int n = 0;
+        // Casas de quadrantes com paridade ímpar primeiro
+        for (int impar = 1; impar >= 0; impar--) {
+            for (uint64_t v = vazias; v; v &= v - 1) {
+                int casa = __builtin_ctzll(v);
+                if ((contar(vazias & quadrante(casa)) & 1) == impar) x[n++] = casa;
+            }
+        }
+        switch (totalVazias) {
+            case 4: return final4(proprias, oponente, alfa, beta, x[0], x[1], x[2], x[3], passou);
+            case 3: return final3(proprias, oponente, alfa, beta, x[0], x[1], x[2], passou);
+            case 2: return final2(proprias, oponente, alfa, beta, x[0], x[1], passou);
+            case 1: return final1(proprias, oponente, x[0]);
+            default: return diferenca(proprias, oponente);
+        }
+    }
+
+    uint64_t jogadas = ReversiBitboard::jogadas_validas(proprias, oponente);
+    if (jogadas == 0) {
+        if (passou) return diferenca(proprias, oponente);
+        return -buscar(oponente, proprias, -beta, -alfa, true);
+    }
+
+    // Com muitas vazias, a tabela de transposição da busca guarda limites e a melhor jogada
+    TabelaTransposicao* tabela = (totalVazias >= VAZIAS_PARA_TABELA) ? contexto_.tabela : nullptr;
+    uint64_t chavePosicao = 0;
+    int casaTabela = -1;
+    if (tabela) {
+        chavePosicao = chave(proprias, oponente);
+        EntradaTT entrada;
+        if (tabela->consultar(chavePosicao, entrada)) {
+            casaTabela = entrada.linha;
+            if (entrada.tipo() == EntradaTT::EXATA) return entrada.pontuacao;
+            if (entrada.tipo() == EntradaTT::INFERIOR && entrada.pontuacao >= beta) return entrada.pontuacao;
+            if (entrada.tipo() == EntradaTT::SUPERIOR && entrada.pontuacao <= alfa) return entrada.pontuacao;
+        }
+    }
+
+    int casas[64];
+    int total = ordenarJogadas(proprias, oponente, jogadas, casas);
+    for (int i = 1; i < total && casaTabela >= 0; i++) {
+        if (casas[i] == casaTabela) {
+            std::rotate(casas, casas + i, casas + i + 1);
+            break;
+        }
+    }
+
+    int alfaOriginal = alfa;
+    int melhor = -65;
+    int melhorCasa = casas[0];
+    for (int i = 0; i < total; i++) {
+        uint64_t viradas = ReversiBitboard::calcular_viradas(casas[i], proprias, oponente);
+        uint64_t depois = proprias | viradas | (1ULL << casas[i]);
+        int valor;
+        if (i == 0) {
+            valor = -buscar(oponente & ~viradas, depois, -beta, -alfa, false);
+        } else {
+            // Janela nula: só confirma que a jogada não supera a melhor até agora; se superar, busca de novo
+            valor = -buscar(oponente & ~viradas, depois, -alfa - 1, -alfa, false);
+            if (valor > alfa && valor < beta) {
+                valor = -buscar(oponente & ~viradas, depois, -beta, -alfa, false);
+            }
+        }
+        if (contexto_.abortada) return 0;
+        if (valor > melhor) {
+            melhor = valor;
+            melhorCasa = casas[i];
+            if (valor > alfa) {
+                alfa = valor;
+                if (alfa >= beta) break;
+            }
+        }
+    }
+
+    if (tabela) {
+        EntradaTT::Tipo tipo = (melhor <= alfaOriginal) ? EntradaTT::SUPERIOR
+                             : (melhor >= beta) ? EntradaTT::INFERIOR : EntradaTT::EXATA;
+        // Resultado exato do fim de jogo: a "profundidade" é o número de vazias
+        tabela->guardar(chavePosicao, totalVazias, melhor, tipo, melhorCasa, -1);
+    }
+    return melhor;
+}
+
+/**
+ * @brief Ordena as jogadas: com muitas vazias, menor mobilidade do oponente primeiro (cantos ganham
+ *        bônus); com poucas, regiões de paridade ímpar primeiro.
+ * @return Número de jogadas escritas em "casas".
+ */
+int SolucionadorFinalReversi::ordenarJogadas(uint64_t proprias, uint64_t oponente, uint64_t jogadas, int* casas) const {
+    uint64_t vazias = ~(proprias | oponente);
+    bool porMobilidade = contar(vazias) > VAZIAS_PARA_MOBILIDADE;
+    int chaves[64];
+    int total = 0;
+
+    for (; jogadas; jogadas &= jogadas - 1) {
+        int casa = __builtin_ctzll(jogadas);
+        uint64_t bit = 1ULL << casa;
+        int chave = (contar(vazias & quadrante(casa)) & 1) ? 0 : 1;
+        if (porMobilidade) {
+            uint64_t viradas = ReversiBitboard::calcular_viradas(casa, proprias, oponente);
+            uint64_t respostas = ReversiBitboard::jogadas_validas(oponente & ~viradas, proprias | viradas | bit);
+            chave += 4 * contar(respostas) + 2 * contar(respostas & CANTOS) - ((bit & CANTOS) ? 4 : 0);
+        }
+        // Inserção: as listas são curtas
+        int i = total++;
+        while (i > 0 && chaves[i - 1] > chave) {
+            chaves[i] = chaves[i - 1];
+            casas[i] = casas[i - 1];
+            i--;
+        }
+        chaves[i] = chave;
+        casas[i] = casa;
+    }
+    return total;
+}
+
+/**
+ * @brief Última casa vazia: joga quem puder (o jogador da vez primeiro), sem busca.
+ */
+int SolucionadorFinalReversi::final1(uint64_t proprias, uint64_t oponente, int x1) {
+    contexto_.nos++;
+    int atual = diferenca(proprias, oponente);
+    uint64_t viradas = ReversiBitboard::calcular_viradas(x1, proprias, oponente);
+    if (viradas) return atual + 2 * contar(viradas) + 1;
+    viradas = ReversiBitboard::calcular_viradas(x1, oponente, proprias);
+    if (viradas) return atual - 2 * contar(viradas) - 1;
+    return atual;
+}
+
+int SolucionadorFinalReversi::final2(uint64_t proprias, uint64_t oponente, int alfa, int beta, int x1, int x2, bool passou) {
+    contexto_.nos++;
+    int melhor = -65;
+    uint64_t viradas;
+
+    if ((viradas = ReversiBitboard::calcular_viradas(x1, proprias, oponente)) != 0) {
+        melhor = -final1(oponente & ~viradas, proprias | viradas | (1ULL << x1), x2);
+        if (melhor >= beta) return melhor;
+    }
+    if ((viradas = ReversiBitboard::calcular_viradas(x2, proprias, oponente)) != 0) {
+        int valor = -final1(oponente & ~viradas, proprias | viradas | (1ULL << x2), x1);
+        if (valor > melhor) melhor = valor;
+    }
+    if (melhor == -65) {
+        if (passou) return diferenca(proprias, oponente);
+        return -final2(oponente, proprias, -beta, -alfa, x1, x2, true);
+    }
+    return melhor;
+}
+
+int SolucionadorFinalReversi::final3(uint64_t proprias, uint64_t oponente, int alfa, int beta, int x1, int x2, int x3, bool passou) {
+    contexto_.nos++;
+    const int x[3] = {x1, x2, x3};
+    int melhor = -65;
+
+    for (int i = 0; i < 3; i++) {
+        uint64_t viradas = ReversiBitboard::calcular_viradas(x[i], proprias, oponente);
+        if (viradas == 0) continue;
+        int a = x[i == 0 ? 1 : 0];
+        int b = x[i == 2 ? 1 : 2];
+        int valor = -final2(oponente & ~viradas, proprias | viradas | (1ULL << x[i]), -beta, -std::max(alfa, melhor), a, b, false);
+        if (valor > melhor) {
+            melhor = valor;
+            if (melhor >= beta) return melhor;
+        }
+    }
+    if (melhor == -65) {
+        if (passou) return diferenca(proprias, oponente);
+        return -final3(oponente, proprias, -beta, -alfa, x1, x2, x3, true);
+    }
+    return melhor;
+}
+
+int SolucionadorFinalReversi::final4(uint64_t proprias, uint64_t oponente, int alfa, int beta, int x1, int x2, int x3, int x4, bool passou) {
+    contexto_.nos++;
+    const int x[4] = {x1, x2, x3, x4};
+    int melhor = -65;
+
+    for (int i = 0; i < 4; i++) {
+        uint64_t viradas = ReversiBitboard::calcular_viradas(x[i], proprias, oponente);
+        if (viradas == 0) continue;
+        int resto[3];
+        for (int j = 0, k = 0; j < 4; j++) {
+            if (j != i) resto[k++] = x[j];
+        }
+        int valor = -final3(oponente & ~viradas, proprias | viradas | (1ULL << x[i]), -beta, -std::max(alfa, melhor),
+                            resto[0], resto[1], resto[2], false);
+        if (valor > melhor) {
+            melhor = valor;
+            if (melhor >= beta) return melhor;
+        }
+    }
+    if (melhor == -65) {
+        if (passou) return diferenca(proprias, oponente);
+        return -final4(oponente, proprias, -beta, -alfa, x1, x2, x3, x4, true);
+    }
+    return melhor;
+}
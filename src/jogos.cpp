@@ -4,25 +4,64 @@
  */
 
 #include "jogos.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <stdexcept>
+#include <string>
 
 
-JogosDeTabuleiro::JogosDeTabuleiro(int linhas, int colunas) : linhas_(linhas), colunas_(colunas){
+JogosDeTabuleiro::JogosDeTabuleiro(int linhas, int colunas) : linhas_(linhas), colunas_(colunas), hash_(0) {
         //Caso o vetor seja inicializado com sem parametros, entao ele sera iniciado com tamanho zero
-        //Caso ele for aumentado, essas novas "casas" serao prenchidas com ' '.
-    Tabuleiro_.resize(linhas, std::vector<int>(colunas, 0));
+        //As casas sao guardadas em um unico bloco, linha a linha, todas iniciadas com 0 (vazia).
+    alocar_celulas();
+}
+
+void JogosDeTabuleiro::alocar_celulas() {
+    int total = linhas_ * colunas_;
+    std::fill(celulas_locais_, celulas_locais_ + CAPACIDADE_LOCAL, 0);
+    celulas_externas_.clear();
+    hash_ = 0;
+    if (total > CAPACIDADE_LOCAL) {
+        celulas_externas_.assign(total, 0);
+    }
 }
 
 int JogosDeTabuleiro::getLinhas() const { return this->linhas_; };
 int JogosDeTabuleiro::getColunas() const { return colunas_; };
-std::vector<std::vector<int>> JogosDeTabuleiro::get_tabuleiro() const { return Tabuleiro_; };
+std::vector<std::vector<int>> JogosDeTabuleiro::get_tabuleiro() const {
+    std::vector<std::vector<int>> tabuleiro(linhas_, std::vector<int>(colunas_, 0));
+    for (int i = 0; i < linhas_; i++) {
+        for (int j = 0; j < colunas_; j++) {
+            tabuleiro[i][j] = at(i, j);
+        }
+    }
+    return tabuleiro;
+};
 char JogosDeTabuleiro::get_casa(int linha, int coluna) const {
     if (linha >= 0 && linha < linhas_ && coluna >= 0 && coluna < colunas_) {
-        return Tabuleiro_[linha][coluna];
+        return at(linha, coluna);
     }
     return 'F';
 }
 
-void JogosDeTabuleiro::setLinhasColunas(int linha, int coluna) { linhas_ = linha; colunas_ = coluna; };
+/**
+ * @brief Chave Zobrist de uma peça do jogador numa casa, gerada por splitmix64 (determinística e sem tabela,
+ *        o que permite tabuleiros de qualquer tamanho).
+ */
+uint64_t JogosDeTabuleiro::chave_zobrist(int casa, int jogador) {
+    uint64_t z = static_cast<uint64_t>(casa) * 2 + static_cast<uint64_t>(jogador) + 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+void JogosDeTabuleiro::definir_casa(int linha, int coluna, int valor) {
+    int casa = linha * colunas_ + coluna;
+    int8_t& atual = dados()[casa];
+    if (atual != 0) hash_ ^= chave_zobrist(casa, atual);
+    if (valor != 0) hash_ ^= chave_zobrist(casa, valor);
+    atual = static_cast<int8_t>(valor);
+}
 
 // jogador 1 é X, jogador 2 é O
 int Reversi::imprimir_vetor(int jogador) const {
@@ -95,18 +134,30 @@ const std::vector<std::pair<int, int>> Reversi::direcoes = {
     {1, -1},  {1, 0},  {1, 1}
 };
 
-Reversi::Reversi(int linhas, int colunas) : JogosDeTabuleiro(linhas, colunas) {
-    JogadasValidas_.resize(linhas, std::vector<bool>(colunas, false));
-    
+Reversi::Reversi(int linhas, int colunas, bool bitboard) : JogosDeTabuleiro(linhas, colunas) {
+    invalidar_jogadas();
+
     // Configuração inicial padrão do Reversi
     // Coloca as 4 peças iniciais no centro do tabuleiro
     int meio_linha = linhas / 2;
     int meio_coluna = colunas / 2;
     
-    Tabuleiro_[meio_linha-1][meio_coluna-1] = 2;   // O
-    Tabuleiro_[meio_linha-1][meio_coluna] = 1;     // X
-    Tabuleiro_[meio_linha][meio_coluna-1] = 1;     // X
-    Tabuleiro_[meio_linha][meio_coluna] = 2;       // O
+    definir_casa(meio_linha-1, meio_coluna-1, 2);   // O
+    definir_casa(meio_linha-1, meio_coluna, 1);     // X
+    definir_casa(meio_linha, meio_coluna-1, 1);     // X
+    definir_casa(meio_linha, meio_coluna, 2);       // O
+
+    // Tabuleiros 8x8 cabem em dois inteiros de 64 bits
+    usa_bitboard_ = bitboard && linhas == 8 && colunas == 8;
+    if (usa_bitboard_) {
+        for (int i = 0; i < linhas; i++) {
+            for (int j = 0; j < colunas; j++) {
+                if (at(i, j) != 0) {
+                    bits_.aplicar(ReversiBitboard::indice(i, j), at(i, j), 0);
+                }
+            }
+        }
+    }
 }
 
 bool Reversi::verificar_direcao(int linha, int coluna, int dLinha, int dColuna, int jogador) const {
@@ -146,6 +197,10 @@ bool Reversi::verificar_jogada(int linha, int coluna, int jogador) const {
     if (get_casa(linha, coluna) != 0) { //Verifica se tentou jogar em uma casa vazia
         return false;
     }
+
+    if (usa_bitboard_) {
+        return (mascara_jogadas(jogador) & ReversiBitboard::bit(linha, coluna)) != 0;
+    }
     
     for (const auto& dir : direcoes) { //verifica todas direcoes
         if (verificar_direcao(linha, coluna, dir.first, dir.second, jogador)) {
@@ -157,35 +212,110 @@ bool Reversi::verificar_jogada(int linha, int coluna, int jogador) const {
 }
 
 int Reversi::ler_jogada(int linha, int coluna, int jogador) {
-    if (!verificar_jogada(linha, coluna, jogador)) { //verifica se a jogada é valida
+    RegistroJogada registro;
+    if (!fazer_jogada(linha, coluna, jogador, registro)) { //verifica se a jogada é valida
         return 0;
     }
-    
-    Tabuleiro_[linha][coluna] = jogador;
-    
-    int oponente = (jogador == 1) ? 2 : 1;
+
+    if (usa_bitboard_) {
+        return ReversiBitboard::contar(registro.viradas);
+    }
+
     int pecas_capturadas = 0;
-    
-    for (const auto& dir : direcoes) {
+    for (int d = 0; d < 8; d++) {
+        pecas_capturadas += registro.viradas_por_direcao[d];
+    }
+    return pecas_capturadas;
+}
+
+bool Reversi::fazer_jogada(int linha, int coluna, int jogador, RegistroJogada& registro) {
+    if (linha < 0 || linha >= getLinhas() || coluna < 0 || coluna >= getColunas() ||
+        get_casa(linha, coluna) != 0) {
+        return false;
+    }
+
+    registro.linha = linha;
+    registro.coluna = coluna;
+    registro.jogador = jogador;
+    registro.viradas = 0;
+
+    if (usa_bitboard_) {
+        int indice = ReversiBitboard::indice(linha, coluna);
+        uint64_t viradas = bits_.calcular_viradas(indice, jogador);
+        if (viradas == 0) return false;
+
+        bits_.aplicar(indice, jogador, viradas);
+        invalidar_jogadas();
+        registro.viradas = viradas;
+        definir_casa(linha, coluna, jogador);
+        for (uint64_t resto = viradas; resto; resto &= resto - 1) {
+            int casa = __builtin_ctzll(resto);
+            definir_casa(casa / 8, casa % 8, jogador);
+        }
+        return true;
+    }
+
+    int oponente = (jogador == 1) ? 2 : 1;
+    bool virou = false;
+
+    for (int d = 0; d < 8; d++) {
+        const auto& dir = direcoes[d];
+        registro.viradas_por_direcao[d] = 0;
         if (verificar_direcao(linha, coluna, dir.first, dir.second, jogador)) {
             int novaLinha = linha + dir.first;
             int novaColuna = coluna + dir.second;
             
             while (get_casa(novaLinha, novaColuna) == oponente) {
-                Tabuleiro_[novaLinha][novaColuna] = jogador;
-                pecas_capturadas++;
+                definir_casa(novaLinha, novaColuna, jogador);
+                registro.viradas_por_direcao[d]++;
                 novaLinha += dir.first;
                 novaColuna += dir.second;
             }
+            virou = true;
+        }
+    }
+
+    if (virou) {
+        definir_casa(linha, coluna, jogador);
+        invalidar_jogadas();
+    }
+    return virou;
+}
+
+void Reversi::desfazer_jogada(const RegistroJogada& registro) {
+    int oponente = (registro.jogador == 1) ? 2 : 1;
+    definir_casa(registro.linha, registro.coluna, 0);
+    invalidar_jogadas();
+
+    if (usa_bitboard_) {
+        bits_.desfazer(ReversiBitboard::indice(registro.linha, registro.coluna), registro.jogador, registro.viradas);
+        for (uint64_t resto = registro.viradas; resto; resto &= resto - 1) {
+            int casa = __builtin_ctzll(resto);
+            definir_casa(casa / 8, casa % 8, oponente);
+        }
+        return;
+    }
+
+    // As peças viradas em cada direção são sempre as primeiras casas a partir da jogada
+    for (int d = 0; d < 8; d++) {
+        for (int k = 1; k <= registro.viradas_por_direcao[d]; k++) {
+            definir_casa(registro.linha + k * direcoes[d].first, registro.coluna + k * direcoes[d].second, oponente);
         }
     }
-    
-    return pecas_capturadas;
 }
 
 std::vector<std::vector<bool>> Reversi::atualizar_jogadas_validas(int jogador) const {
     std::vector<std::vector<bool>> jogadas_validas(getLinhas(), 
                                                   std::vector<bool>(getColunas(), false));
+
+    if (usa_bitboard_) {
+        uint64_t jogadas = mascara_jogadas(jogador);
+        for (; jogadas; jogadas &= jogadas - 1) {
+            int casa = __builtin_ctzll(jogadas);
+            jogadas_validas[casa / 8][casa % 8] = true;
+        }
+        return jogadas_validas;
+    }
     
     for (int i = 0; i < getLinhas(); i++) {
         for (int j = 0; j < getColunas(); j++) {
@@ -195,29 +325,37 @@ std::vector<std::vector<bool>> Reversi::atualizar_jogadas_validas(int jogador) c
     return jogadas_validas;
 }
 
-bool Reversi::testar_condicao_de_vitoria() const {
-    std::vector<std::vector<bool>> jogadas_validas_1 = atualizar_jogadas_validas(1);
-    std::vector<std::vector<bool>> jogadas_validas_2 = atualizar_jogadas_validas(2);
-
-    bool ha_jogadas_1 = false;
-    bool ha_jogadas_2 = false;
-
-    for (const auto& linha : jogadas_validas_1) {
-        for (bool jogada : linha) {
-            if (jogada) ha_jogadas_1 = true;
-        }
+uint64_t Reversi::mascara_jogadas(int jogador) const {
+    if (!usa_bitboard_) {
+        // Sem bitboard não há máscara: 0 seria confundido com "nenhuma jogada válida"
+        throw std::logic_error("mascara_jogadas só vale para o Reversi 8x8 com bitboard (veja usa_bitboard)");
+    }
+    if (!mascaraValida_[jogador - 1]) {
+        mascaras_[jogador - 1] = bits_.jogadas_validas(jogador);
+        mascaraValida_[jogador - 1] = true;
     }
+    return mascaras_[jogador - 1];
+}
 
-    for (const auto& linha : jogadas_validas_2) {
-        for (bool jogada : linha) {
-            if (jogada) ha_jogadas_2 = true;
+bool Reversi::tem_jogadas(int jogador) const {
+    int8_t& tem = temJogadas_[jogador - 1];
+    if (tem < 0) {
+        if (usa_bitboard_) {
+            tem = mascara_jogadas(jogador) != 0;
+        } else {
+            tem = 0;
+            for (int i = 0; i < getLinhas() && !tem; i++) {
+                for (int j = 0; j < getColunas() && !tem; j++) {
+                    tem = verificar_jogada(i, j, jogador);
+                }
+            }
         }
     }
+    return tem != 0;
+}
 
-    if (!ha_jogadas_1 && !ha_jogadas_2) {
-    return true;
-    }
-    return false;
+bool Reversi::testar_condicao_de_vitoria() const {
+    return !tem_jogadas(1) && !tem_jogadas(2);
 }
 
 std::pair<int, int> Reversi::calcular_pontuacao() const {
@@ -275,11 +413,15 @@ int Reversi::anunciar_vencedor() const {
 }
 
 
-JogoDaVelha::JogoDaVelha(int linhas, int colunas) : JogosDeTabuleiro(linhas, colunas) {
+JogoDaVelha::JogoDaVelha(int linhas, int colunas, int k)
+    : JogosDeTabuleiro(linhas, colunas), k_(k), ocupadas_(0), vencedor_(0), casaVencedora_(-1) {
+    if (k < 1 || (k > linhas && k > colunas)) {
+        throw std::invalid_argument("Sequência para vencer não cabe no tabuleiro");
+    }
     // Inicializa o tabuleiro vazio
     for (int i = 0; i < linhas; i++) {
         for (int j = 0; j < colunas; j++) {
-            Tabuleiro_[i][j] = 0;
+            definir_casa(i, j, 0);
         }
     }
 }
@@ -298,50 +440,41 @@ int JogoDaVelha::anunciar_vencedor() const {
 }
 
 int JogoDaVelha::determinar_vencedor() const {
-    // Verifica linhas
-    for (int i = 0; i < getLinhas(); i++) {
-        if (get_casa(i, 0) != 0 && 
-            get_casa(i, 0) == get_casa(i, 1) && 
-            get_casa(i, 1) == get_casa(i, 2)) {
-            return get_casa(i, 0);
-        }
-    }
-    
-    // Verifica colunas
-    for (int j = 0; j < getColunas(); j++) {
-        if (get_casa(0, j) != 0 && 
-            get_casa(0, j) == get_casa(1, j) && 
-            get_casa(1, j) == get_casa(2, j)) {
-            return get_casa(0, j);
+    return vencedor_; // 0: empate ou jogo em andamento
+}
+
+/**
+ * @brief Conta as peças do jogador em sequência pela casa dada, nos dois sentidos da direção.
+ * @return Tamanho da sequência, limitado a k (a casa dada conta como peça do jogador).
+ */
+int JogoDaVelha::contar_sequencia(int linha, int coluna, int dLinha, int dColuna, int jogador) const {
+    int total = 1;
+    for (int sentido = -1; sentido <= 1; sentido += 2) {
+        int l = linha + sentido * dLinha, c = coluna + sentido * dColuna;
+        while (total < k_ && l >= 0 && l < linhas_ && c >= 0 && c < colunas_ && at(l, c) == jogador) {
+            total++;
+            l += sentido * dLinha;
+            c += sentido * dColuna;
         }
     }
-    
-    // Verifica diagonais
-    if (get_casa(0, 0) != 0 && 
-        get_casa(0, 0) == get_casa(1, 1) && 
-        get_casa(1, 1) == get_casa(2, 2)) {
-        return get_casa(0, 0);
-    }
-    
-    if (get_casa(0, 2) != 0 && 
-        get_casa(0, 2) == get_casa(1, 1) && 
-        get_casa(1, 1) == get_casa(2, 0)) {
-        return get_casa(0, 2);
-    }
-    
-    return 0; // Empate ou jogo em andamento
+    return total;
 }
 
-// Nova implementação do método imprimir_vetor
 int JogoDaVelha::imprimir_vetor(int jogador) const {
     std::cout << "\n";
-    
+    int largura = (getLinhas() > 9) ? 2 : 1; // Largura do número da linha
+    std::string margem(largura + 1, ' ');
+
     // Números das colunas
-    std::cout << VERMELHO << "   1   2   3\n" << RESETAR;
-    
+    std::cout << VERMELHO << margem;
+    for (int j = 0; j < this->getColunas(); j++) {
+        std::cout << std::setw(2) << j + 1 << "  ";
+    }
+    std::cout << "\n" << RESETAR;
+
     for (int i = 0; i < this->getLinhas(); i++) {
         // Número da linha e células
-        std::cout << VERMELHO << i + 1 << " " << RESETAR;
+        std::cout << VERMELHO << std::setw(largura) << i + 1 << " " << RESETAR;
         for (int j = 0; j < this->getColunas(); j++) {
             int casa = this->get_casa(i, j);
             // Define o conteúdo da célula
@@ -356,7 +489,7 @@ int JogoDaVelha::imprimir_vetor(int jogador) const {
         
         // Linha horizontal entre as linhas (exceto após a última)
         if (i < this->getLinhas() - 1) {
-            std::cout << "  ";
+            std::cout << margem;
             for (int j = 0; j < this->getColunas(); j++) {
                 std::cout << "___"; // Underscores para a linha
                 if (j < this->getColunas() - 1) std::cout << "|"; // Separador
@@ -375,63 +508,56 @@ bool JogoDaVelha::verificar_jogada(int linha, int coluna, int jogador) const {
     }
     
     // Verifica se a posição está vazia
-    return (get_casa(linha, coluna) == 0);
+    return (at(linha, coluna) == 0);
 }
 
 int JogoDaVelha::ler_jogada(int linha, int coluna, int jogador) {
-    if (!verificar_jogada(linha, coluna, jogador)) {
+    RegistroJogada registro;
+    if (!fazer_jogada(linha, coluna, jogador, registro)) {
         return 0;  // Jogada inválida
     }
-    
-    // Coloca a marca do jogador (1 para X, 2 para O)
-    Tabuleiro_[linha][coluna] = jogador;
     return 1;  // Jogada bem-sucedida
 }
 
-bool JogoDaVelha::testar_condicao_de_vitoria() const {
-    // Verifica linhas
-    for (int i = 0; i < getLinhas(); i++) {
-        if (get_casa(i, 0) != 0 && 
-            get_casa(i, 0) == get_casa(i, 1) && 
-            get_casa(i, 1) == get_casa(i, 2)) {
-            return true;
-        }
-    }
-    
-    // Verifica colunas
-    for (int j = 0; j < getColunas(); j++) {
-        if (get_casa(0, j) != 0 && 
-            get_casa(0, j) == get_casa(1, j) && 
-            get_casa(1, j) == get_casa(2, j)) {
-            return true;
-        }
-    }
-    
-    // Verifica diagonais
-    if (get_casa(0, 0) != 0 && 
-        get_casa(0, 0) == get_casa(1, 1) && 
-        get_casa(1, 1) == get_casa(2, 2)) {
-        return true;
-    }
-    
-    if (get_casa(0, 2) != 0 && 
-        get_casa(0, 2) == get_casa(1, 1) && 
-        get_casa(1, 1) == get_casa(2, 0)) {
-        return true;
+bool JogoDaVelha::fazer_jogada(int linha, int coluna, int jogador, RegistroJogada& registro) {
+    if (!verificar_jogada(linha, coluna, jogador)) {
+        return false;
     }
-    
-    // Verifica empate (tabuleiro cheio)
-    bool tem_espaco_vazio = false;
-    for (int i = 0; i < getLinhas(); i++) {
-        for (int j = 0; j < getColunas(); j++) {
-            if (get_casa(i, j) == 0) {
-                tem_espaco_vazio = true;
+
+    // Coloca a marca do jogador (1 para X, 2 para O)
+    definir_casa(linha, coluna, jogador);
+    ocupadas_++;
+    registro.linha = linha;
+    registro.coluna = coluna;
+    registro.jogador = jogador;
+
+    // Só as sequências que passam pela casa jogada podem ter chegado a k
+    if (vencedor_ == 0) {
+        const int direcoes[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+        for (const auto& d : direcoes) {
+            if (contar_sequencia(linha, coluna, d[0], d[1], jogador) >= k_) {
+                vencedor_ = jogador;
+                casaVencedora_ = linha * colunas_ + coluna;
                 break;
             }
         }
     }
-    
-    return !tem_espaco_vazio;  // Retorna true se o tabuleiro estiver cheio (empate)
+    return true;
+}
+
+void JogoDaVelha::desfazer_jogada(const RegistroJogada& registro) {
+    definir_casa(registro.linha, registro.coluna, 0);
+    ocupadas_--;
+    // As jogadas são desfeitas em ordem inversa: antes da jogada vencedora, ninguém tinha vencido
+    if (registro.linha * colunas_ + registro.coluna == casaVencedora_) {
+        vencedor_ = 0;
+        casaVencedora_ = -1;
+    }
+}
+
+bool JogoDaVelha::testar_condicao_de_vitoria() const {
+    // Alguém venceu ou o tabuleiro está cheio (empate)
+    return vencedor_ != 0 || ocupadas_ == linhas_ * colunas_;
 }
 
 int Lig4::imprimir_vetor(int jogador) const {
@@ -464,6 +590,33 @@ int Lig4::imprimir_vetor(int jogador) const {
 
 
 int Lig4::determinar_vencedor() const {
+    if (usa_bitboard_) {
+        return bits_.vencedor();
+    }
+    return vencedor_;
+}
+
+/**
+ * @brief Verifica se a peça do jogador em (linha, coluna) completa quatro em linha em alguma direção.
+ */
+bool Lig4::alinhou_em(int linha, int coluna, int jogador) const {
+    const int direcoes[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+    for (const auto& d : direcoes) {
+        int total = 1;
+        for (int sentido = -1; sentido <= 1; sentido += 2) {
+            int l = linha + sentido * d[0], c = coluna + sentido * d[1];
+            while (total < 4 && l >= 0 && l < linhas_ && c >= 0 && c < colunas_ && at(l, c) == jogador) {
+                total++;
+                l += sentido * d[0];
+                c += sentido * d[1];
+            }
+        }
+        if (total >= 4) return true;
+    }
+    return false;
+}
+
+int Lig4::vencedor_por_varredura() const {
     int linhas = getLinhas();
     int colunas = getColunas();
 
@@ -531,17 +684,12 @@ int Lig4::anunciar_vencedor() const {
     return vencedor;
 }
 bool Lig4::testar_condicao_de_vitoria() const {
-    if (determinar_vencedor() != 0) {
-        return true;
+    if (usa_bitboard_) {
+        return bits_.cheio() || bits_.vencedor() != 0;
     }
 
-    // Verifica se todas as colunas estão cheias (empate)
-    for (int col = 0; col < getColunas(); ++col) {
-        if (get_casa(0, col) == 0) {
-            return false;
-        }
-    }
-    return true;
+    // Alguém venceu ou todas as colunas estão cheias (empate)
+    return vencedor_ != 0 || ocupadas_ == linhas_ * colunas_;
 }
 
 
@@ -551,32 +699,73 @@ bool Lig4::verificar_jogada(int linha, int coluna, int jogador) const {
             return false;  
         }
 
-        for (int linha = 0; linha < getLinhas(); ++linha) {
-            if (get_casa(linha, coluna) == 0) {
-                return true;  
-            }
+        if (usa_bitboard_) {
+            return bits_.pode_jogar(coluna);
         }
-        return false;  
+
+        // As peças se empilham de baixo para cima: a coluna tem espaço enquanto a casa do topo estiver vazia
+        return getLinhas() > 0 && at(0, coluna) == 0;
     }
 int Lig4::ler_jogada(int linha, int coluna, int jogador) {
-    if (!verificar_jogada(0, coluna, jogador)) { 
+    RegistroJogada registro;
+    if (!fazer_jogada(linha, coluna, jogador, registro)) { 
         return -1; // Indica jogada inválida
     }
+    return registro.linha; // Retorna a linha onde a peça foi colocada
+}
+
+bool Lig4::fazer_jogada(int linha, int coluna, int jogador, RegistroJogada& registro) {
+    if (!verificar_jogada(0, coluna, jogador)) { 
+        return false;
+    }
+
+    registro.coluna = coluna;
+    registro.jogador = jogador;
+
+    if (usa_bitboard_) {
+        registro.linha = getLinhas() - 1 - bits_.jogar(coluna, jogador);
+        definir_casa(registro.linha, coluna, jogador);
+        return true;
+    }
 
     for (int i = getLinhas() - 1; i >= 0; --i) { 
-        if (get_casa(i, coluna) == 0) {
-            Tabuleiro_[i][coluna] = jogador;
-            return i; // Retorna a linha onde a peça foi colocada
+        if (at(i, coluna) == 0) {
+            definir_casa(i, coluna, jogador);
+            registro.linha = i;
+            ocupadas_++;
+            if (vencedor_ == 0 && alinhou_em(i, coluna, jogador)) {
+                vencedor_ = jogador;
+                casaVencedora_ = i * colunas_ + coluna;
+            }
+            return true;
         }
     }
-    return -1; // Não deve ocorrer se a jogada foi validada
+    return false; // Não deve ocorrer se a jogada foi validada
+}
+
+void Lig4::desfazer_jogada(const RegistroJogada& registro) {
+    definir_casa(registro.linha, registro.coluna, 0);
+    if (usa_bitboard_) {
+        bits_.desfazer(registro.coluna);
+        return;
+    }
+    ocupadas_--;
+    // As jogadas são desfeitas em ordem inversa: antes da jogada vencedora, ninguém tinha vencido
+    if (registro.linha * colunas_ + registro.coluna == casaVencedora_) {
+        vencedor_ = 0;
+        casaVencedora_ = -1;
+    }
 }
 
-Lig4::Lig4(int linhas, int colunas) : JogosDeTabuleiro(linhas, colunas) {
+Lig4::Lig4(int linhas, int colunas, bool bitboard) 
+    : JogosDeTabuleiro(linhas, colunas), 
+      usa_bitboard_(bitboard && Lig4Bitboard::cabe(linhas, colunas)), 
+      bits_(linhas, colunas),
+      ocupadas_(0), vencedor_(0), casaVencedora_(-1) {
     // Inicializa o tabuleiro vazio
     for (int i = 0; i < linhas; i++) {
         for (int j = 0; j < colunas; j++) {
-            Tabuleiro_[i][j] = 0;
+            definir_casa(i, j, 0);
         }
     }
 };
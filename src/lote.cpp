@@ -0,0 +1,161 @@
+/**
+ * @file lote.cpp
+ * @brief Declaração dos métodos da classe Lote.
+ */
+
+#include "lote.hpp"
+#include "jogos.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+
+namespace {
+
+/// Separa a linha em campos por espaços, reaproveitando o vetor entre as linhas.
+void separarCampos(const std::string& linha, std::vector<std::string>& campos) {
+    campos.clear();
+    std::size_t i = 0;
+    while (i < linha.size()) {
+        while (i < linha.size() && (linha[i] == ' ' || linha[i] == '\t' || linha[i] == '\r')) i++;
+        std::size_t inicio = i;
+        while (i < linha.size() && linha[i] != ' ' && linha[i] != '\t' && linha[i] != '\r') i++;
+        if (i > inicio) campos.push_back(linha.substr(inicio, i - inicio));
+    }
+}
+
+/// Número de uma jogada (a partir de 1), convertido para índice a partir de 0.
+int lerIndice(const std::string& campo) {
+    char* fim = nullptr;
+    long valor = std::strtol(campo.c_str(), &fim, 10);
+    if (campo.empty() || *fim != '\0' || valor < 1 || valor > 1000) {
+        throw std::invalid_argument("Jogada inválida: " + campo);
+    }
+    return static_cast<int>(valor) - 1;
+}
+
+} // namespace
+
+Lote::Lote(Cadastro& jogadores, const std::string& caminho, int checkpoint)
+    : jogadores_(jogadores), caminho_(caminho), checkpoint_(checkpoint), comandos_(0), erros_(0),
+      alteracoesPendentes_(0) {}
+
+int Lote::executar(std::istream& entrada, std::ostream& saida) {
+    std::string linha;
+    std::vector<std::string> campos;
+    int numeroLinha = 0;
+
+    while (std::getline(entrada, linha)) {
+        ++numeroLinha;
+        separarCampos(linha, campos);
+        if (campos.empty() || campos[0][0] == '#') continue;
+
+        ++comandos_;
+        try {
+            executarComando(campos, saida);
+        } catch (const std::exception& e) {
+            ++erros_;
+            saida << "Erro na linha " << numeroLinha << ": " << e.what() << '\n';
+        }
+    }
+    salvarSePendente();
+    return erros_;
+}
+
+void Lote::executarComando(const std::vector<std::string>& campos, std::ostream& saida) {
+    std::string comando = campos[0];
+    std::transform(comando.begin(), comando.end(), comando.begin(), ::toupper);
+
+    if (comando == "CJ") {
+        if (campos.size() < 3) throw std::invalid_argument("Uso: CJ <apelido> <nome>");
+        // O nome é o resto da linha depois do apelido
+        std::string nome = campos[2];
+        for (std::size_t i = 3; i < campos.size(); i++) nome += " " + campos[i];
+        if (nome.find(',') != std::string::npos || campos[1].find(',') != std::string::npos) {
+            throw std::invalid_argument("Nome e apelido não podem ter vírgulas");
+        }
+        jogadores_.adicionarJogador(Jogador(nome, campos[1]));
+    } else if (comando == "RJ") {
+        if (campos.size() != 2) throw std::invalid_argument("Uso: RJ <apelido>");
+        jogadores_.removeJogador(Jogador("", campos[1]));
+    } else if (comando == "LJ") {
+        for (const auto& jogador : jogadores_.get_jogadores()) saida << jogador->serializar() << '\n';
+        return;
+    } else if (comando == "EP") {
+        executarPartida(campos);
+    } else {
+        throw std::invalid_argument("Comando desconhecido: " + comando);
+    }
+
+    ++alteracoesPendentes_;
+    if (checkpoint_ > 0 && alteracoesPendentes_ >= checkpoint_) salvarSePendente();
+}
+
+void Lote::executarPartida(const std::vector<std::string>& campos) {
+    if (campos.size() < 4) throw std::invalid_argument("Uso: EP <V|L|R> <apelido1> <apelido2> <jogadas...>");
+    const std::string& tipo = campos[1];
+    std::unique_ptr<JogosDeTabuleiro> jogo;
+    if (tipo == "V" || tipo == "1") {
+        jogo.reset(new JogoDaVelha());
+    } else if (tipo == "L" || tipo == "2") {
+        jogo.reset(new Lig4());
+    } else if (tipo == "R" || tipo == "3") {
+        jogo.reset(new Reversi());
+    } else {
+        throw std::invalid_argument("Tipo de jogo inválido: " + tipo);
+    }
+
+    Jogador* jogadores[2] = {jogadores_.find(campos[2]), jogadores_.find(campos[3])};
+    for (int i = 0; i < 2; i++) {
+        if (!jogadores[i]) throw std::invalid_argument("Jogador '" + campos[2 + i] + "' não encontrado");
+    }
+    if (jogadores[0] == jogadores[1]) throw std::invalid_argument("Os dois jogadores da partida são o mesmo");
+
+    // As jogadas são feitas inteiras antes de alterar o cadastro: uma partida inválida não conta
+    Reversi* reversi = dynamic_cast<Reversi*>(jogo.get());
+    bool lig4 = dynamic_cast<Lig4*>(jogo.get()) != nullptr;
+    int porJogada = lig4 ? 1 : 2;
+    if ((campos.size() - 4) % porJogada != 0) throw std::invalid_argument("Jogada incompleta no fim da linha");
+
+    int jogador = 1;
+    RegistroJogada registro;
+    for (std::size_t i = 4; i < campos.size(); i += porJogada) {
+        if (jogo->testar_condicao_de_vitoria()) throw std::invalid_argument("Jogadas depois do fim da partida");
+        if (reversi && !reversi->tem_jogadas(jogador)) jogador = (jogador == 1) ? 2 : 1;
+        int linha = lig4 ? 0 : lerIndice(campos[i]);
+        int coluna = lerIndice(campos[i + porJogada - 1]);
+        if (!jogo->verificar_jogada(linha, coluna, jogador) || !jogo->fazer_jogada(linha, coluna, jogador, registro)) {
+            throw std::invalid_argument("Jogada inválida do jogador " + std::to_string(jogador) + ": " +
+                                        (lig4 ? campos[i] : campos[i] + " " + campos[i + 1]));
+        }
+        jogador = (jogador == 1) ? 2 : 1;
+    }
+    if (!jogo->testar_condicao_de_vitoria()) throw std::invalid_argument("Partida incompleta");
+
+    // O determinar_vencedor do Reversi imprime o placar: aqui bastam as peças
+    int vencedor;
+    if (reversi) {
+        std::pair<int, int> pecas = reversi->calcular_pontuacao();
+        vencedor = pecas.first > pecas.second ? 1 : (pecas.second > pecas.first ? 2 : 0);
+    } else {
+        vencedor = jogo->determinar_vencedor();
+    }
+    if (vencedor == 0) return; // Empate não muda o placar
+
+    Jogador* ganhador = jogadores[vencedor - 1];
+    Jogador* perdedor = jogadores[2 - vencedor];
+    Winrate& vitorias = reversi ? ganhador->getReversi() : (lig4 ? ganhador->getLig4() : ganhador->getVelha());
+    Winrate& derrotas = reversi ? perdedor->getReversi() : (lig4 ? perdedor->getLig4() : perdedor->getVelha());
+    ganhador->setVitorias(vitorias, vitorias._vitorias + 1);
+    perdedor->setDerrotas(derrotas, derrotas._derrotas + 1);
+    jogadores_.registrarAlteracao(*ganhador);
+    jogadores_.registrarAlteracao(*perdedor);
+}
+
+void Lote::salvarSePendente() {
+    if (alteracoesPendentes_ == 0) return;
+    jogadores_.save(caminho_);
+    alteracoesPendentes_ = 0;
+}
@@ -9,7 +9,12 @@
 #include "cadastro.hpp"
 #include "jogos.hpp"
 #include "partida.hpp"
+#include "threadpool.hpp"
+#include "lote.hpp"
 #include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
 
 /**
  * @brief Exibe o menu de comandos do sistema.
@@ -44,8 +49,7 @@ void cadastrarJogador(Cadastro& jogadores) {
     Jogador novoJogador(nome, apelido);
 
     if (!jogadores.check(novoJogador)) {
-        jogadores.adicionarJogador(novoJogador);
-        jogadores.save("cadastro.txt");
+        jogadores.adicionarJogador(novoJogador); // Registrado no diário do cadastro
     } else {
         std::cout << "ERRO: Jogador já cadastrado!" << std::endl;
     }
@@ -62,8 +66,7 @@ void removerJogador(Cadastro& jogadores) {
     std::getline(std::cin, apelido);
 
     Jogador alvo("", apelido);
-    jogadores.removeJogador(alvo);
-    jogadores.save("cadastro.txt");
+    jogadores.removeJogador(alvo); // Registrado no diário do cadastro
 }
 
 /**
@@ -87,8 +90,9 @@ void procurarJogador(const Cadastro& jogadores) {
 /**
  * @brief Inicia uma nova partida entre dois jogadores ou contra um bot.
  * @param jogadores Referência ao objeto Cadastro para gerenciar jogadores.
+ * @param pool Threads usadas pelos bots durante a partida.
  */
-void iniciarNovaPartida(Cadastro& jogadores) {
+void iniciarNovaPartida(Cadastro& jogadores, ThreadPool& pool) {
     std::string apelido1, apelido2;
     int tipoJogo;
     bool vsBot = false;
@@ -121,51 +125,104 @@ void iniciarNovaPartida(Cadastro& jogadores) {
     std::cin.ignore();
     std::getline(std::cin, apelido1);
 
-    Jogador jogador1("", apelido1);
-    if (!jogadores.check(jogador1)) {
+    Jogador* jogador1 = jogadores.find(apelido1);
+    if (!jogador1) {
         std::cout << VERMELHO << "Jogador 1 não encontrado!" << RESETAR << std::endl;
         return;
     }
 
-    for (const auto& jogador : jogadores.get_jogadores()) {
-        if (jogador->getApelido() == apelido1) {
-            if (!vsBot) {
-                std::cout << "Digite o apelido do Jogador 2: ";
-                std::getline(std::cin, apelido2);
-                Jogador jogador_teste("", apelido2);
-                if (!jogadores.check(jogador_teste)) {
-                    std::cout << VERMELHO << "Jogador 2 não encontrado!" << RESETAR << std::endl;
-                    return;
-                }
-                for (const auto& jogador2 : jogadores.get_jogadores()) {
-                    if (jogador2->getApelido() == apelido2) {
-                        Partida partida(tipoJogo, jogador.get(), jogador2.get());
-                        partida.iniciarPartida();
-                        break;
-                    }
-                }
-            } else {
-                if (jogador->getApelido() == apelido1) {
-                    Partida partida(tipoJogo, jogador.get());
-                    partida.iniciarPartida();
-                }
-            }
+    if (!vsBot) {
+        std::cout << "Digite o apelido do Jogador 2: ";
+        std::getline(std::cin, apelido2);
+        Jogador* jogador2 = jogadores.find(apelido2);
+        if (!jogador2) {
+            std::cout << VERMELHO << "Jogador 2 não encontrado!" << RESETAR << std::endl;
+            return;
         }
-}
+        Partida partida(tipoJogo, jogador1, jogador2);
+        partida.iniciarPartida();
+        jogadores.registrarAlteracao(*jogador2);
+    } else {
+        int dificuldade;
+        std::cout << "Dificuldade do BOT (1-Fácil, 2-Médio, 3-Difícil, 4-Perfeito): ";
+        std::cin >> dificuldade;
+        Partida partida(tipoJogo, jogador1, &pool);
+        partida.iniciarPartida(dificuldade);
+    }
 
-// Após a partida, salva as atualizações do cadastro
-jogadores.save("cadastro.txt");
-std::cout << NEGRITO << DIVIDER << RESETAR << std::endl;
+    // Após a partida, registra o novo placar no diário do cadastro
+    jogadores.registrarAlteracao(*jogador1);
+    std::cout << NEGRITO << DIVIDER << RESETAR << std::endl;
 }
 
 
+/**
+ * @brief Modo em lote: executa os comandos de um arquivo (ou da entrada padrão, com "-" ou sem arquivo)
+ *        sem menus nem cores, salvando o cadastro no fim ou a cada checkpoint.
+ * @return 0 se todos os comandos foram executados, 1 se algum falhou e 2 em caso de uso incorreto.
+ */
+int executarLote(int argc, char* argv[]) {
+    // A saída do lote não se mistura com printf: o cin e o cout podem usar buffers próprios
+    std::ios::sync_with_stdio(false);
+    std::cin.tie(nullptr);
+
+    std::string arquivo = "-";
+    int checkpoint = 0;
+    for (int i = 2; i < argc; i++) {
+        if (std::strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc) {
+            checkpoint = std::atoi(argv[++i]);
+        } else if (arquivo == "-") {
+            arquivo = argv[i];
+        } else {
+            std::cerr << "Uso: main --lote [arquivo|-] [--checkpoint N]\n";
+            return 2;
+        }
+    }
+
+    Cadastro jogadores;
+    jogadores.setVerboso(false);
+    {
+        ThreadPool pool(ThreadPool::nucleosDisponiveis() - 1);
+        jogadores.import("cadastro.txt", pool);
+    }
+
+    Lote lote(jogadores, "cadastro.txt", checkpoint);
+    int erros;
+    if (arquivo == "-") {
+        erros = lote.executar(std::cin, std::cout);
+    } else {
+        std::ifstream entrada(arquivo);
+        if (!entrada.is_open()) {
+            std::cerr << "Não foi possível abrir o arquivo de comandos: " << arquivo << "\n";
+            return 2;
+        }
+        erros = lote.executar(entrada, std::cout);
+    }
+    std::cout << "Comandos: " << lote.getComandos() << ", erros: " << erros << "\n";
+    return erros > 0 ? 1 : 0;
+}
+
 /**
  * @brief Função principal do programa.
  * @return Retorna 0 em caso de execução bem-sucedida.
  */
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::strcmp(argv[1], "--lote") == 0) {
+        try {
+            return executarLote(argc, argv);
+        } catch (const std::exception& e) {
+            std::cerr << "Erro: " << e.what() << "\n";
+            return 2;
+        }
+    }
+
+    // Criado uma vez e reaproveitado na importação e em todas as partidas; a thread principal também trabalha
+    ThreadPool pool(ThreadPool::nucleosDisponiveis() - 1);
+
     Cadastro jogadores;
-    jogadores.import("cadastro.txt");
+    jogadores.import("cadastro.txt", pool);
+    jogadores.abrirDiario("cadastro.txt");
+    jogadores.setIntervaloSincronizacao(std::chrono::milliseconds(100)); // Resultados próximos: um fsync só
 
     std::vector<std::string> commands = {"CJ", "RJ", "LJ", "PJ", "NP", "F", "H"};
     std::string inputComando;
@@ -203,9 +260,10 @@ int main() {
             procurarJogador(jogadores);
             break;
         case 4: // NP
-            iniciarNovaPartida(jogadores);
+            iniciarNovaPartida(jogadores, pool);
             break;
         case 5: // F
+            jogadores.compactar();
             std::cout << "Programa finalizado." << std::endl;
             return 0;
         case 6: // H
@@ -0,0 +1,262 @@
+/**
+ * @file mcts.cpp
+ * @brief Declaração dos métodos da classe MCTSReversiBot.
+ */
+
+#include "mcts.hpp"
+#include "threadpool.hpp"
+#include <cmath>
+#include <future>
+
+namespace {
+
+const double EXPLORACAO = 1.41421356; // Constante c do UCT (raiz de 2)
+const int MAX_CAMINHO = 192;           // 60 jogadas mais os passes, com folga
+
+/// Gerador xorshift64*: rápido e suficiente para escolher jogadas aleatórias.
+inline uint64_t proximoAleatorio(uint64_t& estado) {
+    estado ^= estado >> 12;
+    estado ^= estado << 25;
+    estado ^= estado >> 27;
+    return estado * 0x2545f4914f6cdd1dULL;
+}
+
+/// Escolhe uniformemente um dos bits ligados da máscara (que não pode ser vazia).
+inline int bitAleatorio(uint64_t mascara, uint64_t& estado) {
+    int k = static_cast<int>(proximoAleatorio(estado) % ReversiBitboard::contar(mascara));
+    while (k-- > 0) {
+        mascara &= mascara - 1;
+    }
+    return __builtin_ctzll(mascara);
+}
+
+} // namespace
+
+MCTSReversiBot::MCTSReversiBot(int simulacoes, ThreadPool* pool, std::size_t capacidade)
+    : ReversiBot(6, pool), simulacoes_(simulacoes), semente_(0x9e3779b97f4a7c15ULL),
+      arena_(capacidade < 2 ? 2 : capacidade), usados_(0) {}
+
+std::pair<int, int> MCTSReversiBot::calcularProximaJogada(const JogosDeTabuleiro& jogoBase, int jogadorAtual) {
+    return calcularProximaJogada(jogoBase, jogadorAtual, LimiteBusca::porNos(simulacoes_));
+}
+
+/**
+ * @brief Roda simulações até o orçamento acabar e escolhe o filho da raiz mais visitado.
+ * @param jogoBase Estado atual do jogo (Reversi).
+ * @param jogadorAtual ID do jogador que fará a jogada.
+ * @param limite Número de simulações (maxNos) e/ou prazo; sem nenhum dos dois, usa getSimulacoes().
+ * @return A jogada escolhida, ou (-1, -1) se não houver jogadas válidas.
+ */
+std::pair<int, int> MCTSReversiBot::calcularProximaJogada(const JogosDeTabuleiro& jogoBase, int jogadorAtual, const LimiteBusca& limite) {
+    if (jogoBase.getLinhas() != 8 || jogoBase.getColunas() != 8) {
+        return ReversiBot::calcularProximaJogada(jogoBase, jogadorAtual, limite);
+    }
+    // No final, a solução exata é melhor e mais rápida que as simulações. O orçamento de simulações
+    // não vale como orçamento de nós do solucionador: sem prazo, vale o getPrazoFinal() do bot; com
+    // prazo, a solução usa no máximo metade do tempo e o resto fica para as simulações se ela estourar
+    LimiteBusca limiteFinal = limite;
+    limiteFinal.maxNos = 0;
+    if (limite.prazo != LimiteBusca::Relogio::time_point::max()) {
+        LimiteBusca::Relogio::time_point agora = LimiteBusca::Relogio::now();
+        if (limite.prazo > agora) limiteFinal.prazo = agora + (limite.prazo - agora) / 2;
+    }
+    std::pair<int, int> jogadaFinal;
+    if (resolverFinal(static_cast<const Reversi&>(jogoBase), jogadorAtual, limiteFinal, jogadaFinal)) {
+        return jogadaFinal;
+    }
+
+    ReversiBitboard raiz;
+    uint64_t pecas[2] = {0, 0};
+    for (int linha = 0; linha < 8; linha++) {
+        for (int coluna = 0; coluna < 8; coluna++) {
+            int casa = jogoBase.at(linha, coluna);
+            if (casa != 0) pecas[casa - 1] |= ReversiBitboard::bit(linha, coluna);
+        }
+    }
+    raiz.set_pecas(1, pecas[0]);
+    raiz.set_pecas(2, pecas[1]);
+
+    uint64_t jogadas = raiz.jogadas_validas(jogadorAtual);
+    if (jogadas == 0) {
+        return {-1, -1};
+    }
+
+    LimiteBusca orcamento = limite;
+    if (orcamento.maxNos <= 0 && orcamento.prazo == LimiteBusca::Relogio::time_point::max()) {
+        orcamento.maxNos = simulacoes_;
+    }
+
+    usados_ = 0; // Reinicia a arena: a árvore da jogada anterior é descartada
+    novoNo(raiz, NoMCTS::PASSE, (jogadorAtual == 1) ? 2 : 1);
+
+    std::atomic<long long> simulacoes(0);
+    int threads = (pool_ && ReversiBitboard::contar(jogadas) > 1) ? threads_ : 1;
+    std::vector<int> profundidades(threads, 0);
+    std::vector<std::future<void>> auxiliares;
+    for (int i = 1; i < threads; i++) {
+        uint64_t semente = semente_ + 0x9e3779b97f4a7c15ULL * i;
+        auxiliares.push_back(pool_->enviar([this, &raiz, jogadorAtual, &orcamento, &simulacoes, semente, &profundidades, i]() {
+            simular(raiz, jogadorAtual, orcamento, simulacoes, semente, profundidades[i]);
+        }));
+    }
+    simular(raiz, jogadorAtual, orcamento, simulacoes, semente_, profundidades[0]);
+    for (std::future<void>& auxiliar : auxiliares) {
+        auxiliar.get();
+    }
+    semente_ = proximoAleatorio(semente_);
+
+    // O filho mais visitado é a escolha mais robusta
+    int escolhido = -1;
+    for (int filho = arena_[0].primeiroFilho; filho >= 0; filho = arena_[filho].proximoIrmao) {
+        if (escolhido < 0 || arena_[filho].visitas > arena_[escolhido].visitas) {
+            escolhido = filho;
+        }
+    }
+    int casa = (escolhido >= 0) ? arena_[escolhido].casa : __builtin_ctzll(jogadas);
+
+    nosVisitados_ = arena_[0].visitas; // Cada simulação passa pela raiz
+    profundidadeAlcancada_ = 0;
+    for (int p : profundidades) {
+        if (p > profundidadeAlcancada_) profundidadeAlcancada_ = p;
+    }
+    return {casa / 8, casa % 8};
+}
+
+/**
+ * @brief Cria um nó na arena para a posição resultante de uma jogada.
+ * @param tabuleiro Posição depois da jogada.
+ * @param casa Casa jogada, ou NoMCTS::PASSE.
+ * @param jogador Quem fez a jogada.
+ * @return Índice do nó criado.
+ */
+int MCTSReversiBot::novoNo(const ReversiBitboard& tabuleiro, int casa, int jogador) {
+    int indice = static_cast<int>(usados_++);
+    int proximo = (jogador == 1) ? 2 : 1;
+    NoMCTS& no = arena_[indice];
+    no.pendentes = tabuleiro.jogadas_validas(proximo);
+    no.primeiroFilho = -1;
+    no.proximoIrmao = -1;
+    no.visitas = 0;
+    no.vitorias = 0.0f;
+    no.casa = static_cast<int8_t>(casa);
+    no.jogador = static_cast<uint8_t>(jogador);
+    no.passePendente = (no.pendentes == 0 && tabuleiro.jogadas_validas(jogador) != 0);
+    return indice;
+}
+
+/**
+ * @brief Filho com maior valor UCT: taxa de vitórias mais o bônus de exploração.
+ */
+int MCTSReversiBot::melhorFilho(int pai) const {
+    double logVisitas = std::log(static_cast<double>(arena_[pai].visitas));
+    int melhor = -1;
+    double melhorValor = -1.0;
+    for (int filho = arena_[pai].primeiroFilho; filho >= 0; filho = arena_[filho].proximoIrmao) {
+        const NoMCTS& no = arena_[filho];
+        double valor = no.vitorias / no.visitas + EXPLORACAO * std::sqrt(logVisitas / no.visitas);
+        if (valor > melhorValor) {
+            melhorValor = valor;
+            melhor = filho;
+        }
+    }
+    return melhor;
+}
+
+/**
+ * @brief Laço de simulações de uma thread, até o orçamento compartilhado acabar.
+ * @param raiz Posição da raiz.
+ * @param jogador Jogador da vez na raiz.
+ * @param limite Número total de simulações e/ou prazo.
+ * @param simulacoes Contador compartilhado de simulações iniciadas.
+ * @param semente Semente do gerador aleatório desta thread.
+ * @param profundidade Recebe a maior profundidade da árvore alcançada por esta thread.
+ */
+void MCTSReversiBot::simular(const ReversiBitboard& raiz, int jogador, const LimiteBusca& limite,
+                             std::atomic<long long>& simulacoes, uint64_t semente, int& profundidade) {
+    uint64_t aleatorio = semente | 1;
+    int caminho[MAX_CAMINHO];
+
+    while (true) {
+        long long n = simulacoes.fetch_add(1, std::memory_order_relaxed);
+        if (limite.maxNos > 0 && n >= limite.maxNos) break;
+        if ((n & 15) == 0 && limite.prazo != LimiteBusca::Relogio::time_point::max() &&
+            LimiteBusca::Relogio::now() >= limite.prazo) break;
+
+        ReversiBitboard tabuleiro = raiz;
+        int vez = jogador;
+        int tamanho = 0;
+        {
+            std::lock_guard<std::mutex> trava(arvore_);
+            int atual = 0;
+            caminho[tamanho++] = atual;
+            arena_[atual].visitas++;
+
+            while (tamanho < MAX_CAMINHO) {
+                NoMCTS& no = arena_[atual];
+                int filho;
+                if (no.pendentes != 0 || no.passePendente) {
+                    if (usados_ >= arena_.size()) break; // Arena cheia: simula a partir daqui
+                    int casa = NoMCTS::PASSE;
+                    if (no.pendentes != 0) {
+                        casa = bitAleatorio(no.pendentes, aleatorio);
+                        no.pendentes &= ~(1ULL << casa);
+                        tabuleiro.aplicar(casa, vez, tabuleiro.calcular_viradas(casa, vez));
+                    } else {
+                        no.passePendente = false;
+                    }
+                    filho = novoNo(tabuleiro, casa, vez);
+                    arena_[filho].proximoIrmao = arena_[atual].primeiroFilho;
+                    arena_[atual].primeiroFilho = filho;
+                    arena_[filho].visitas++;
+                    caminho[tamanho++] = filho;
+                    vez = (vez == 1) ? 2 : 1;
+                    break;
+                }
+                if (no.primeiroFilho < 0) break; // Fim de jogo
+
+                filho = melhorFilho(atual);
+                if (arena_[filho].casa != NoMCTS::PASSE) {
+                    tabuleiro.aplicar(arena_[filho].casa, vez, tabuleiro.calcular_viradas(arena_[filho].casa, vez));
+                }
+                // A visita conta antes do resultado: é a perda virtual vista pelas outras threads
+                arena_[filho].visitas++;
+                caminho[tamanho++] = filho;
+                vez = (vez == 1) ? 2 : 1;
+                atual = filho;
+            }
+        }
+        if (tamanho - 1 > profundidade) profundidade = tamanho - 1;
+
+        int vencedor = jogarAteOFim(tabuleiro, vez, aleatorio);
+
+        std::lock_guard<std::mutex> trava(arvore_);
+        for (int i = 0; i < tamanho; i++) {
+            NoMCTS& no = arena_[caminho[i]];
+            if (vencedor == no.jogador) no.vitorias += 1.0f;
+            else if (vencedor == 0) no.vitorias += 0.5f;
+        }
+    }
+}
+
+/**
+ * @brief Termina a partida com jogadas aleatórias.
+ * @return O vencedor (1 ou 2), ou 0 em caso de empate.
+ */
+int MCTSReversiBot::jogarAteOFim(ReversiBitboard tabuleiro, int jogador, uint64_t& aleatorio) {
+    int passes = 0;
+    while (passes < 2) {
+        uint64_t jogadas = tabuleiro.jogadas_validas(jogador);
+        if (jogadas == 0) {
+            passes++;
+        } else {
+            passes = 0;
+            int casa = bitAleatorio(jogadas, aleatorio);
+            tabuleiro.aplicar(casa, jogador, tabuleiro.calcular_viradas(casa, jogador));
+        }
+        jogador = (jogador == 1) ? 2 : 1;
+    }
+
+    int pecas1 = ReversiBitboard::contar(tabuleiro.pecas(1));
+    int pecas2 = ReversiBitboard::contar(tabuleiro.pecas(2));
+    return (pecas1 > pecas2) ? 1 : (pecas2 > pecas1) ? 2 : 0;
+}
@@ -4,6 +4,7 @@
  */
 
 #include "partida.hpp"
+#include "mcts.hpp"
 #include <iostream>
 #include <memory>
 #include <chrono>
@@ -14,9 +15,10 @@
  * @brief Construtor para criar uma partida com um jogador humano e um bot.
  * @param tipoJogo Tipo do jogo (1 - Jogo da Velha, 2 - Lig4, 3 - Reversi).
  * @param jogador1 Ponteiro para o primeiro jogador humano.
+ * @param pool Threads que o bot pode usar na busca (nullptr = busca sequencial). Não pertence à partida.
  * @throws std::invalid_argument Se o tipo de jogo for inválido.
  */
-Partida::Partida(int tipoJogo, Jogador* jogador1) : jogador1(jogador1), jogador2(nullptr) {
+Partida::Partida(int tipoJogo, Jogador* jogador1, ThreadPool* pool) : jogador1(jogador1), jogador2(nullptr), pool(pool) {
     try {
         switch (tipoJogo) {
             case 1:
@@ -29,7 +31,7 @@ Partida::Partida(int tipoJogo, Jogador* jogador1) : jogador1(jogador1), jogador2
                 break;
             case 3:
                 jogoAtual.reset(new Reversi());
-                bot1 = new ReversiBot();
+                bot1 = new ReversiBot(6, pool);
                 break;
             default:
                 throw std::invalid_argument("Tipo de jogo inválido");
@@ -49,7 +51,7 @@ Partida::Partida(int tipoJogo, Jogador* jogador1) : jogador1(jogador1), jogador2
  * @throws std::invalid_argument Se o tipo de jogo for inválido.
  */
 Partida::Partida(int tipoJogo, Jogador* jogador1, Jogador* jogador2) 
-    : jogador1(jogador1), jogador2(jogador2), bot1(nullptr), bot2(nullptr) {
+    : jogador1(jogador1), jogador2(jogador2), bot1(nullptr), bot2(nullptr), pool(nullptr) {
     try {
         switch (tipoJogo) {
             case 1:
@@ -192,11 +194,49 @@ bool Partida::iniciarPartida() {
 
 /**
  * @brief Sobrecarga para iniciar uma partida com dificuldade específica.
- * @param dificuldade Nível de dificuldade para bots (não implementado).
+ *
+ * No Reversi o bot passa a ser o MCTSReversiBot, com mais simulações por jogada a cada nível
+ * (no nível 4, o final também é resolvido de forma exata mais cedo); no Lig4 a dificuldade define
+ * a profundidade da busca, e o nível 4 liga o modo de jogo perfeito. No Lig4, o jogo só é perfeito
+ * desde o começo com a tabela de abertura "abertura_lig4.txt" (gerada pela ferramenta "abertura");
+ * sem ela, enquanto o solucionador não termina dentro do prazo, vale a busca heurística de
+ * profundidade 9. O bot do Jogo da Velha já joga de forma perfeita e não muda.
+ *
+ * @param dificuldade Nível de dificuldade do bot: 1 (fácil), 2 (médio), 3 (difícil) ou 4 (perfeito).
  * @return true se a partida foi concluída com sucesso, false em caso de erro.
  */
 bool Partida::iniciarPartida(int dificuldade) {
-    // Implementação futura para diferentes níveis de dificuldade
+    static const int SIMULACOES_REVERSI[4] = {500, 3000, 15000, 15000};
+    static const int PROFUNDIDADE_LIG4[4] = {3, 6, 9, 9};
+    const int PERFEITO = 4;
+
+    if (dificuldade < 1 || dificuldade > PERFEITO) {
+        std::cerr << "Erro: Dificuldade inválida (use 1, 2, 3 ou 4)!" << std::endl;
+        return false;
+    }
+    if (bot1) {
+        if (dynamic_cast<Reversi*>(jogoAtual.get())) {
+            MCTSReversiBot* bot = new MCTSReversiBot(SIMULACOES_REVERSI[dificuldade - 1], pool);
+            if (dificuldade == PERFEITO) {
+                // Finais de 16 vazias costumam ser resolvidos em até 1-2 s; se o prazo estourar, valem as simulações
+                bot->setLimiarFinal(16);
+                bot->setPrazoFinal(std::chrono::milliseconds(2000));
+            }
+            delete bot1;
+            bot1 = bot;
+        } else if (dynamic_cast<Lig4*>(jogoAtual.get())) {
+            Lig4Bot* bot = new Lig4Bot(PROFUNDIDADE_LIG4[dificuldade - 1]);
+            if (dificuldade == PERFEITO) {
+                bot->setModoPerfeito(true);
+                if (!bot->carregarAbertura("abertura_lig4.txt")) {
+                    std::cout << "Sem a tabela de abertura (gerada com \"make abertura\"), o bot só joga de forma "
+                                 "perfeita a partir do meio da partida." << std::endl;
+                }
+            }
+            delete bot1;
+            bot1 = bot;
+        }
+    }
     return iniciarPartida();
 }
 
@@ -233,7 +273,7 @@ bool Partida::realizarJogada(int jogadorAtual, int linha, int coluna) {
                 tentativas++;
                 
                 if (jogada_achada) {
-                    std::cout << "\nA IA está pensando...\n";
+                    std::cout << "\nA IA está pensando... (" << botAtual->getNosVisitados() << " posições analisadas)\n";
                     std::this_thread::sleep_for(std::chrono::seconds(2));
                     return jogoAtual->ler_jogada(botLinha, botColuna, jogadorAtual);
                 }
@@ -292,13 +332,7 @@ bool Partida::realizarJogada(int jogadorAtual, int linha, int coluna) {
 bool Partida::verificarJogadasDisponiveis(int jogadorAtual) const {
     try {
         if (auto* reversi = dynamic_cast<Reversi*>(jogoAtual.get())) {
-            auto jogadas = reversi->atualizar_jogadas_validas(jogadorAtual);
-            for (const auto& linha : jogadas) {
-                for (bool jogada : linha) {
-                    if (jogada) return true;
-                }
-            }
-            return false;
+            return reversi->tem_jogadas(jogadorAtual);
         }
 
         if (auto* lig4 = dynamic_cast<Lig4*>(jogoAtual.get())) {
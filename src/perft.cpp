@@ -0,0 +1,180 @@
+/**
+ * @file perft.cpp
+ * @brief Declaração dos métodos da classe Perft.
+ */
+
+#include "perft.hpp"
+#include "threadpool.hpp"
+#include <stdexcept>
+
+const char* Perft::nome(Implementacao implementacao) {
+    switch (implementacao) {
+        case REFERENCIA: return "referencia";
+        case TABULEIRO: return "tabuleiro";
+        default: return "bits";
+    }
+}
+
+// --- Reversi ---
+
+long long Perft::reversi(Reversi& jogo, int jogador, int profundidade) {
+    if (profundidade == 0) return 1;
+    int oponente = (jogador == 1) ? 2 : 1;
+    long long folhas = 0;
+    bool jogou = false;
+    RegistroJogada registro;
+
+    for (int linha = 0; linha < jogo.getLinhas(); linha++) {
+        for (int coluna = 0; coluna < jogo.getColunas(); coluna++) {
+            if (!jogo.verificar_jogada(linha, coluna, jogador)) continue;
+            jogo.fazer_jogada(linha, coluna, jogador, registro);
+            folhas += reversi(jogo, oponente, profundidade - 1);
+            jogo.desfazer_jogada(registro);
+            jogou = true;
+        }
+    }
+    if (jogou) return folhas;
+    // Sem jogadas: passa a vez, ou o jogo acabou se o oponente também não pode jogar
+    return jogo.tem_jogadas(oponente) ? reversi(jogo, oponente, profundidade - 1) : 1;
+}
+
+long long Perft::reversi(uint64_t proprias, uint64_t oponente, int profundidade) {
+    if (profundidade == 0) return 1;
+    uint64_t jogadas = ReversiBitboard::jogadas_validas(proprias, oponente);
+    if (jogadas == 0) {
+        return ReversiBitboard::jogadas_validas(oponente, proprias) ? reversi(oponente, proprias, profundidade - 1) : 1;
+    }
+    if (profundidade == 1) return ReversiBitboard::contar(jogadas);
+
+    long long folhas = 0;
+    for (; jogadas; jogadas &= jogadas - 1) {
+        int casa = __builtin_ctzll(jogadas);
+        uint64_t viradas = ReversiBitboard::calcular_viradas(casa, proprias, oponente);
+        folhas += reversi(oponente & ~viradas, proprias | viradas | (1ULL << casa), profundidade - 1);
+    }
+    return folhas;
+}
+
+long long Perft::reversi(Implementacao implementacao, int profundidade, int tamanho) {
+    if (implementacao == BITS) {
+        if (tamanho != 8) {
+            throw std::invalid_argument("A implementação em bits do Reversi é só para o tabuleiro 8x8");
+        }
+        return reversi(ReversiBitboard::bit(4, 3) | ReversiBitboard::bit(3, 4),
+                       ReversiBitboard::bit(3, 3) | ReversiBitboard::bit(4, 4), profundidade);
+    }
+    Reversi jogo(tamanho, tamanho, implementacao == TABULEIRO);
+    return reversi(jogo, 1, profundidade);
+}
+
+// --- Lig4 ---
+
+long long Perft::lig4(Lig4& jogo, int jogador, int profundidade) {
+    if (profundidade == 0 || jogo.testar_condicao_de_vitoria()) return 1;
+    int oponente = (jogador == 1) ? 2 : 1;
+    long long folhas = 0;
+    RegistroJogada registro;
+    for (int coluna = 0; coluna < jogo.getColunas(); coluna++) {
+        if (!jogo.fazer_jogada(0, coluna, jogador, registro)) continue;
+        folhas += lig4(jogo, oponente, profundidade - 1);
+        jogo.desfazer_jogada(registro);
+    }
+    return folhas;
+}
+
+long long Perft::lig4(Lig4Bitboard& bits, int jogador, int profundidade) {
+    if (profundidade == 0 || bits.cheio() || bits.vencedor() != 0) return 1;
+    int oponente = (jogador == 1) ? 2 : 1;
+    long long folhas = 0;
+    for (int coluna = 0; coluna < bits.getColunas(); coluna++) {
+        if (!bits.pode_jogar(coluna)) continue;
+        bits.jogar(coluna, jogador);
+        folhas += lig4(bits, oponente, profundidade - 1);
+        bits.desfazer(coluna);
+    }
+    return folhas;
+}
+
+long long Perft::lig4(Implementacao implementacao, int profundidade, int linhas, int colunas) {
+    if (implementacao == BITS) {
+        if (!Lig4Bitboard::cabe(linhas, colunas)) {
+            throw std::invalid_argument("Tabuleiro de Lig4 grande demais para a implementação em bits");
+        }
+        Lig4Bitboard bits(linhas, colunas);
+        return lig4(bits, 1, profundidade);
+    }
+    Lig4 jogo(linhas, colunas, implementacao == TABULEIRO);
+    return lig4(jogo, 1, profundidade);
+}
+
+// --- Paralelo ---
+
+long long Perft::paralelo(ThreadPool& pool, const std::string& jogo, Implementacao implementacao,
+                          int profundidade, int linhas, int colunas) {
+    if (jogo != "reversi" && jogo != "lig4") {
+        throw std::invalid_argument("Jogo desconhecido para o perft: " + jogo);
+    }
+    if (profundidade <= 1) {
+        return jogo == "reversi" ? reversi(implementacao, profundidade, linhas) : lig4(implementacao, profundidade, linhas, colunas);
+    }
+
+    // Uma tarefa por jogada da raiz, cada uma com a sua cópia da posição
+    std::vector<long long> folhas;
+    std::vector<std::future<void>> futuros;
+    if (jogo == "reversi") {
+        if (implementacao == BITS && linhas != 8) {
+            throw std::invalid_argument("A implementação em bits do Reversi é só para o tabuleiro 8x8");
+        }
+        Reversi raiz(linhas, linhas, implementacao != REFERENCIA);
+        std::vector<int> casas;
+        for (int linha = 0; linha < linhas; linha++) {
+            for (int coluna = 0; coluna < linhas; coluna++) {
+                if (raiz.verificar_jogada(linha, coluna, 1)) casas.push_back(linha * linhas + coluna);
+            }
+        }
+        folhas.assign(casas.size(), 0);
+        for (std::size_t i = 0; i < casas.size(); i++) {
+            int casa = casas[i];
+            futuros.push_back(pool.enviar([&raiz, &folhas, i, casa, implementacao, profundidade, linhas]() {
+                Reversi copia = raiz;
+                copia.ler_jogada(casa / linhas, casa % linhas, 1);
+                if (implementacao == BITS) {
+                    uint64_t pecas[2] = {0, 0};
+                    for (int l = 0; l < 8; l++)
+                        for (int c = 0; c < 8; c++)
+                            if (copia.at(l, c) != 0) pecas[copia.at(l, c) - 1] |= ReversiBitboard::bit(l, c);
+                    folhas[i] = reversi(pecas[1], pecas[0], profundidade - 1);
+                } else {
+                    folhas[i] = reversi(copia, 2, profundidade - 1);
+                }
+            }));
+        }
+    } else {
+        if (implementacao == BITS && !Lig4Bitboard::cabe(linhas, colunas)) {
+            throw std::invalid_argument("Tabuleiro de Lig4 grande demais para a implementação em bits");
+        }
+        folhas.assign(colunas, 0);
+        for (int coluna = 0; coluna < colunas; coluna++) {
+            futuros.push_back(pool.enviar([&folhas, coluna, implementacao, profundidade, linhas, colunas]() {
+                if (implementacao == BITS) {
+                    Lig4Bitboard bits(linhas, colunas);
+                    bits.jogar(coluna, 1);
+                    folhas[coluna] = lig4(bits, 2, profundidade - 1);
+                } else {
+                    Lig4 copia(linhas, colunas, implementacao == TABULEIRO);
+                    copia.ler_jogada(0, coluna, 1);
+                    folhas[coluna] = lig4(copia, 2, profundidade - 1);
+                }
+            }));
+        }
+    }
+
+    // Espera todas as tarefas antes de repassar uma exceção: elas usam variáveis desta função
+    for (std::future<void>& futuro : futuros) futuro.wait();
+    long long total = 0;
+    for (std::size_t i = 0; i < futuros.size(); i++) {
+        futuros[i].get();
+        total += folhas[i];
+    }
+    return total;
+}
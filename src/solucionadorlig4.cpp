@@ -0,0 +1,326 @@
+/**
+ * @file solucionadorlig4.cpp
+ * @brief Declaração dos métodos da classe SolucionadorLig4.
+ */
+
+#include "solucionadorlig4.hpp"
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+const int L = SolucionadorLig4::LARGURA;
+const int A = SolucionadorLig4::ALTURA;
+const int CASAS = L * A;
+const int MINIMO = -CASAS / 2 + 3;     // Pior valor possível (perder na última jogada do oponente)
+const int MAXIMO = (CASAS + 1) / 2 - 3;
+
+/// Máscara com um bit por coluna, na linha de baixo.
+const uint64_t FUNDO = 0x0040810204081ULL;
+const uint64_t TABULEIRO = FUNDO * ((1ULL << A) - 1);
+
+/// Colunas do centro para as bordas.
+const int ORDEM_COLUNAS[L] = {3, 2, 4, 1, 5, 0, 6};
+
+inline uint64_t colunaInteira(int coluna) { return ((1ULL << A) - 1) << (coluna * (A + 1)); }
+inline uint64_t fundoColuna(int coluna) { return 1ULL << (coluna * (A + 1)); }
+inline uint64_t topoColuna(int coluna) { return 1ULL << (A - 1 + coluna * (A + 1)); }
+
+inline int contar(uint64_t mascara) { return __builtin_popcountll(mascara); }
+
+/// Casas livres onde o dono de "pecas" completaria quatro em linha (jogáveis agora ou não).
+uint64_t casasVencedoras(uint64_t pecas, uint64_t mascara) {
+    // Vertical
+    uint64_t r = (pecas << 1) & (pecas << 2) & (pecas << 3);
+
+    // Horizontal e as duas diagonais: três peças e a casa livre em qualquer posição da janela
+    const int deslocamentos[3] = {A + 1, A, A + 2};
+    for (int d : deslocamentos) {
+        uint64_t p = (pecas << d) & (pecas << 2 * d);
+        r |= p & (pecas << 3 * d);
+        r |= p & (pecas >> d);
+        p = (pecas >> d) & (pecas >> 2 * d);
+        r |= p & (pecas << d);
+        r |= p & (pecas >> 3 * d);
+    }
+    return r & (TABULEIRO ^ mascara);
+}
+
+inline uint64_t jogaveis(uint64_t mascara) { return (mascara + FUNDO) & TABULEIRO; }
+
+inline bool venceAgora(uint64_t proprias, uint64_t mascara) {
+    return (casasVencedoras(proprias, mascara) & jogaveis(mascara)) != 0;
+}
+
+/**
+ * @brief Jogadas que não entregam a vitória imediata ao oponente (0 se todas entregam).
+ *        Supõe que o jogador da vez não vence nesta jogada.
+ */
+uint64_t jogadasSemDerrota(uint64_t proprias, uint64_t mascara) {
+    uint64_t possiveis = jogaveis(mascara);
+    uint64_t ameacasOponente = casasVencedoras(proprias ^ mascara, mascara);
+    uint64_t forcadas = possiveis & ameacasOponente;
+    if (forcadas) {
+        if (forcadas & (forcadas - 1)) return 0; // Duas ameaças do oponente: não há defesa
+        possiveis = forcadas;
+    }
+    // Não jogar logo abaixo de uma casa vencedora do oponente
+    return possiveis & ~(ameacasOponente >> 1);
+}
+
+inline uint64_t chave(uint64_t proprias, uint64_t mascara) { return proprias + mascara; }
+
+/// Espalha os bits da chave para a tabela de transposição (que usa os bits baixos como índice).
+inline uint64_t chaveTabela(uint64_t k) {
+    k = (k ^ (k >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    k = (k ^ (k >> 27)) * 0x94d049bb133111ebULL;
+    return k ^ (k >> 31);
+}
+
+} // namespace
+
+/**
+ * @brief Valor exato da posição por busca binária com janelas nulas.
+ */
+int SolucionadorLig4::valor(uint64_t proprias, uint64_t mascara, ContextoBusca& contexto) const {
+    int jogadas = contar(mascara);
+    if (venceAgora(proprias, mascara)) {
+        return (CASAS + 1 - jogadas) / 2;
+    }
+    int minimo = -(CASAS - jogadas) / 2;
+    int maximo = (CASAS + 1 - jogadas) / 2;
+
+    while (minimo < maximo && !contexto.abortada) {
+        int meio = minimo + (maximo - minimo) / 2;
+        // Testa primeiro valores perto de zero, que separam vitória, empate e derrota
+        if (meio <= 0 && minimo / 2 < meio) meio = minimo / 2;
+        else if (meio >= 0 && maximo / 2 > meio) meio = maximo / 2;
+
+        int r = negamax(proprias, mascara, meio, meio + 1, contexto);
+        if (r <= meio) maximo = r;
+        else minimo = r;
+    }
+    return minimo;
+}
+
+/**
+ * @brief Escolhe a melhor jogada: resolve a posição e depois procura, na ordem das ameaças, a
+ *        primeira coluna cujo valor confirma o da posição (uma janela nula por coluna).
+ */
+int SolucionadorLig4::resolver(uint64_t proprias, uint64_t mascara, ContextoBusca& contexto, int& melhorColuna) const {
+    melhorColuna = -1;
+    uint64_t possiveis = jogaveis(mascara);
+    if (possiveis == 0) {
+        return 0;
+    }
+
+    uint64_t vencedoras = casasVencedoras(proprias, mascara) & possiveis;
+    for (int coluna : ORDEM_COLUNAS) {
+        if (vencedoras & colunaInteira(coluna)) {
+            melhorColuna = coluna;
+            return (CASAS + 1 - contar(mascara)) / 2;
+        }
+    }
+
+    int resultado = valor(proprias, mascara, contexto);
+    if (contexto.abortada) {
+        return 0;
+    }
+
+    uint64_t candidatas = jogadasSemDerrota(proprias, mascara);
+    for (int coluna : ORDEM_COLUNAS) {
+        if (candidatas == 0 && (possiveis & colunaInteira(coluna))) {
+            melhorColuna = coluna; // Derrota inevitável: qualquer coluna serve
+            break;
+        }
+        uint64_t jogada = candidatas & colunaInteira(coluna);
+        if (jogada == 0) continue;
+        if (melhorColuna < 0) melhorColuna = coluna;
+
+        uint64_t novaMascara = mascara | jogada;
+        uint64_t oponente = proprias ^ mascara;
+        // A jogada é ótima se o oponente não consegue mais que -resultado
+        int r = -negamax(oponente, novaMascara, -resultado, -resultado + 1, contexto);
+        if (contexto.abortada) return 0;
+        if (r >= resultado) {
+            melhorColuna = coluna;
+            break;
+        }
+    }
+    return resultado;
+}
+
+/**
+ * @brief Negamax com poda alfa-beta; supõe que o jogador da vez não vence nesta jogada.
+ */
+int SolucionadorLig4::negamax(uint64_t proprias, uint64_t mascara, int alfa, int beta, ContextoBusca& contexto) const {
+    contexto.nos++;
+    if (contexto.deveParar()) {
+        return 0;
+    }
+
+    int jogadas = contar(mascara);
+    uint64_t proximas = jogadasSemDerrota(proprias, mascara);
+    if (proximas == 0) {
+        return -(CASAS - jogadas) / 2; // O oponente vence na próxima jogada
+    }
+    if (jogadas >= CASAS - 2) {
+        return 0; // Empate: ninguém vence nas duas últimas casas
+    }
+
+    int minimo = -(CASAS - 2 - jogadas) / 2; // O oponente não vence na próxima jogada
+    if (alfa < minimo) {
+        alfa = minimo;
+        if (alfa >= beta) return alfa;
+    }
+    int maximo = (CASAS - 1 - jogadas) / 2;  // O jogador não vence nesta jogada
+    if (beta > maximo) {
+        beta = maximo;
+        if (alfa >= beta) return beta;
+    }
+
+    uint64_t k = chave(proprias, mascara);
+    if (jogadas <= jogadasAbertura_) {
+        std::unordered_map<uint64_t, int8_t>::const_iterator it = abertura_.find(k);
+        if (it != abertura_.end()) return it->second;
+    }
+
+    EntradaTT entrada;
+    uint64_t kTabela = chaveTabela(k);
+    if (contexto.tabela && contexto.tabela->consultar(kTabela, entrada)) {
+        if (entrada.tipo() == EntradaTT::SUPERIOR && beta > entrada.pontuacao) {
+            beta = entrada.pontuacao;
+            if (alfa >= beta) return beta;
+        } else if (entrada.tipo() == EntradaTT::INFERIOR && alfa < entrada.pontuacao) {
+            alfa = entrada.pontuacao;
+            if (alfa >= beta) return alfa;
+        }
+    }
+
+    // Ordena pelas ameaças criadas; empates mantêm a ordem do centro para as bordas
+    uint64_t candidatas[L];
+    int pontos[L];
+    int total = 0;
+    for (int coluna : ORDEM_COLUNAS) {
+        uint64_t jogada = proximas & colunaInteira(coluna);
+        if (jogada == 0) continue;
+        int ameacas = contar(casasVencedoras(proprias | jogada, mascara | jogada));
+        int i = total++;
+        while (i > 0 && pontos[i - 1] < ameacas) {
+            candidatas[i] = candidatas[i - 1];
+            pontos[i] = pontos[i - 1];
+            i--;
+        }
+        candidatas[i] = jogada;
+        pontos[i] = ameacas;
+    }
+
+    uint64_t oponente = proprias ^ mascara;
+    for (int i = 0; i < total; i++) {
+        int r = -negamax(oponente, mascara | candidatas[i], -beta, -alfa, contexto);
+        if (contexto.abortada) return 0;
+        if (r >= beta) {
+            if (contexto.tabela) contexto.tabela->guardar(kTabela, CASAS - jogadas, r, EntradaTT::INFERIOR, -1, -1);
+            return r;
+        }
+        if (r > alfa) alfa = r;
+    }
+
+    if (contexto.tabela) contexto.tabela->guardar(kTabela, CASAS - jogadas, alfa, EntradaTT::SUPERIOR, -1, -1);
+    return alfa;
+}
+
+bool SolucionadorLig4::carregarAbertura(const std::string& caminho) {
+    std::ifstream arquivo(caminho);
+    if (!arquivo.is_open()) {
+        return false;
+    }
+
+    std::string linha;
+    int numeroLinha = 0;
+    while (std::getline(arquivo, linha)) {
+        ++numeroLinha;
+        if (linha.empty()) continue;
+
+        std::istringstream campos(linha);
+        std::string sequencia;
+        int valorPosicao;
+        if (!(campos >> sequencia >> valorPosicao) || valorPosicao < MINIMO - 1 || valorPosicao > MAXIMO + 1) {
+            throw std::invalid_argument("Erro na linha " + std::to_string(numeroLinha) + ": formato inválido");
+        }
+
+        // Refaz a sequência para obter a posição; "proprias" é sempre do jogador da vez
+        uint64_t proprias = 0, mascara = 0;
+        if (sequencia != "-") {
+            for (char c : sequencia) {
+                int coluna = c - '1';
+                if (coluna < 0 || coluna >= L || (mascara & topoColuna(coluna))) {
+                    throw std::invalid_argument("Erro na linha " + std::to_string(numeroLinha) + ": jogada inválida");
+                }
+                proprias ^= mascara;
+                mascara |= mascara + fundoColuna(coluna);
+            }
+        }
+        abertura_[chave(proprias, mascara)] = static_cast<int8_t>(valorPosicao);
+        jogadasAbertura_ = std::max(jogadasAbertura_, contar(mascara));
+    }
+    return true;
+}
+
+/**
+ * @brief Gera a tabela de abertura. As posições são resolvidas da mais profunda para a inicial, e
+ *        cada valor entra na tabela em memória: a solução de uma posição encontra as das filhas
+ *        prontas, então o custo fica concentrado nas posições com "jogadas" peças.
+ */
+void SolucionadorLig4::gravarAbertura(const std::string& caminho, int jogadas, ContextoBusca& contexto,
+                                      const std::function<void(int, std::size_t)>& progresso) {
+    std::ofstream arquivo(caminho);
+    if (!arquivo.is_open()) {
+        throw std::runtime_error("Não foi possível abrir o arquivo para escrita: " + caminho);
+    }
+
+    struct Posicao {
+        uint64_t proprias, mascara;
+        std::string sequencia;
+    };
+    // Uma lista de posições por número de peças, sem repetições
+    std::vector<std::vector<Posicao>> niveis(1, std::vector<Posicao>(1, Posicao{0, 0, "-"}));
+    std::unordered_set<uint64_t> vistas;
+    vistas.insert(chave(0, 0));
+    for (int nivel = 0; nivel < jogadas; nivel++) {
+        std::vector<Posicao> proximo;
+        for (const Posicao& atual : niveis[nivel]) {
+            for (int coluna = 0; coluna < L; coluna++) {
+                uint64_t jogada = jogaveis(atual.mascara) & colunaInteira(coluna);
+                // Posições depois de uma vitória não fazem parte da tabela
+                if (jogada == 0 || (casasVencedoras(atual.proprias, atual.mascara) & jogada)) continue;
+                uint64_t proprias = atual.proprias ^ atual.mascara, mascara = atual.mascara | jogada;
+                if (!vistas.insert(chave(proprias, mascara)).second) continue;
+                std::string sequencia = (atual.sequencia == "-" ? "" : atual.sequencia) + char('1' + coluna);
+                proximo.push_back(Posicao{proprias, mascara, sequencia});
+            }
+        }
+        niveis.push_back(std::move(proximo));
+    }
+
+    for (int nivel = static_cast<int>(niveis.size()) - 1; nivel >= 0; nivel--) {
+        if (progresso) progresso(nivel, niveis[nivel].size());
+        for (const Posicao& atual : niveis[nivel]) {
+            int v = valor(atual.proprias, atual.mascara, contexto);
+            if (contexto.abortada) {
+                throw std::runtime_error("Geração da tabela de abertura interrompida pelo limite da busca");
+            }
+            abertura_[chave(atual.proprias, atual.mascara)] = static_cast<int8_t>(v);
+            jogadasAbertura_ = std::max(jogadasAbertura_, nivel);
+            arquivo << atual.sequencia << ' ' << v << '\n';
+        }
+    }
+    if (!arquivo) {
+        throw std::runtime_error("Falha ao escrever no arquivo");
+    }
+}
@@ -0,0 +1,20 @@
+/**
+ * @file tabelavelha.cpp
+ * @brief Instância da tabela de jogadas perfeitas do Jogo da Velha, calculada em tempo de compilação.
+ */
+
+#include "tabelavelha.hpp"
+
+namespace {
+
+constexpr TabelaVelha TABELA;
+
+// O jogo perfeito a partir do tabuleiro vazio é empate, começando pelo centro
+static_assert(TABELA.consultar(0, 1).valor == 0, "Jogo da Velha perfeito deve empatar");
+static_assert(TABELA.consultar(0, 1).casa == 4, "A primeira jogada preferida é o centro");
+
+} // namespace
+
+const TabelaVelha& tabelaVelha() {
+    return TABELA;
+}
@@ -8,8 +8,19 @@
 #include "jogos.hpp"
 #include "partida.hpp"
 #include "botplayer.hpp"
+#include "threadpool.hpp"
+#include "mcts.hpp"
+#include "finalreversi.hpp"
+#include "tabelavelha.hpp"
+#include "perft.hpp"
+#include "arena.hpp"
+#include "lote.hpp"
+#include "cadastrobinario.hpp"
 #include <stdexcept>
 #include <sstream>
+#include <fstream>
+#include <cstdio>
+#include <algorithm>
 
 TEST_CASE("Teste de serialização e desserialização do Jogador") {
     Jogador jogador("João Silva", "joaosilva", 10, 5, 8, 3, 7, 2);
@@ -44,6 +55,34 @@ TEST_CASE("Teste de serialização e desserialização do Jogador") {
     }
 }
 
+TEST_CASE("Teste da leitura sem alocações do Jogador") {
+    // Mesmas regras e mensagens da conversão com std::stoi
+    CHECK(Jogador::deserializar("Ana,ana, 7,+3,12abc,0,0,0\r").serializar() == "Ana,ana,7,3,12,0,0,0");
+    CHECK_THROWS_WITH(Jogador::deserializar("Ana,ana,x,0,0,0,0,0"),
+                      "Erro na deserialização: vitórias do jogo da velha: stoi");
+    CHECK_THROWS_WITH(Jogador::deserializar("Ana,ana,0,0,0,0,0,99999999999"),
+                      "Erro na deserialização: derrotas do Reversi: stoi");
+    CHECK_THROWS_WITH(Jogador::deserializar("Ana,ana,0,0,-1,0,0,0"),
+                      "Erro na deserialização: vitórias do Lig 4: vitórias do Lig 4 não pode ser negativo");
+    CHECK_THROWS_WITH(Jogador::deserializar("Ana,ana,0,0,0,0,0,"),
+                      "Erro na deserialização: derrotas do Reversi: stoi");
+    CHECK_THROWS_WITH(Jogador::deserializar(",ana,0,0,0,0,0,0"),
+                      "Erro na deserialização: Nome ou apelido não podem estar vazios");
+    CHECK_THROWS_WITH(Jogador::deserializar(""),
+                      "Erro na deserialização: Formato inválido na string de entrada: esperado 8 campos, encontrado 1");
+    CHECK_THROWS_WITH(Jogador::deserializar("a,b,1,2,3,4,5,6,7"),
+                      "Erro na deserialização: Formato inválido na string de entrada: esperado 8 campos, encontrado 9");
+
+    // Um erro não altera o jogador
+    Jogador jogador("Beto", "beto", 1, 2, 3, 4, 5, 6);
+    std::string linha = "Caio,caio,1,1,1,1,1,-1";
+    CHECK_THROWS_AS(jogador.preencher(linha.data(), linha.data() + linha.size()), std::runtime_error);
+    CHECK(jogador.serializar() == "Beto,beto,1,2,3,4,5,6");
+    linha = "Caio,caio,1,1,1,1,1,1";
+    jogador.preencher(linha.data(), linha.data() + linha.size());
+    CHECK(jogador.serializar() == linha);
+}
+
 TEST_CASE("Teste de adição e remoção de jogadores no Cadastro") {
     Cadastro cadastro;
     Jogador jogador1("João Silva", "joaosilva", 10, 5, 8, 3, 7, 2);
@@ -72,6 +111,46 @@ TEST_CASE("Teste de adição e remoção de jogadores no Cadastro") {
     }
 }
 
+TEST_CASE("Teste do índice por apelido do Cadastro") {
+    Cadastro cadastro;
+    cadastro.setVerboso(false);
+    for (int i = 0; i < 100; i++) {
+        cadastro.adicionarJogador(Jogador("Jogador " + std::to_string(i), "j" + std::to_string(i), i));
+    }
+    REQUIRE(cadastro.find("j42") != nullptr);
+    CHECK(cadastro.find("j42")->getNome() == "Jogador 42");
+    CHECK(cadastro.find("ninguem") == nullptr);
+
+    // Remoções no começo, no meio e no fim: o índice acompanha o jogador que troca de posição
+    cadastro.removeJogador(Jogador("", "j0"));
+    cadastro.removeJogador(Jogador("", "j50"));
+    cadastro.removeJogador(Jogador("", "j99"));
+    CHECK(cadastro.get_jogadores().size() == 97);
+    CHECK(cadastro.find("j0") == nullptr);
+    CHECK(cadastro.find("j99") == nullptr);
+    for (int i = 1; i < 99; i++) {
+        Jogador* jogador = cadastro.find("j" + std::to_string(i));
+        if (i == 50) {
+            CHECK(jogador == nullptr);
+        } else {
+            REQUIRE(jogador != nullptr);
+            CHECK(jogador->getVitorias(jogador->getVelha()) == i);
+        }
+    }
+    cadastro.adicionarJogador(Jogador("De novo", "j0"));
+    CHECK(cadastro.check(Jogador("", "j0")));
+
+    // Apelido repetido no arquivo é erro de importação
+    const char* caminho = "test_repetidos.txt";
+    {
+        std::ofstream arquivo(caminho);
+        arquivo << "A,a,0,0,0,0,0,0\nB,b,0,0,0,0,0,0\nC,a,0,0,0,0,0,0\n";
+    }
+    CHECK_THROWS_WITH_AS(cadastro.import(caminho), doctest::Contains("linha 3"), std::runtime_error);
+    CHECK(cadastro.find("b") == nullptr);
+    std::remove(caminho);
+}
+
 TEST_CASE("Teste de importação e salvamento de jogadores") {
     Cadastro cadastro;
     std::string caminhoArquivo = "test_jogadores.txt";
@@ -157,6 +236,120 @@ TEST_CASE("Testando a classe Reversi") {
     }
 }
 
+TEST_CASE("Testando as jogadas válidas guardadas do Reversi") {
+    // As máscaras guardadas devem acompanhar fazer_jogada e desfazer_jogada
+    for (int tamanho : {8, 6}) {
+        Reversi reversi(tamanho, tamanho);
+        std::vector<RegistroJogada> registros;
+        int jogador = 1, divergencias = 0;
+        for (int n = 0; !reversi.testar_condicao_de_vitoria(); n++) {
+            // Referência calculada do zero: bitboards montados das casas (8x8) ou casa a casa (demais)
+            uint64_t pecas[2] = {0, 0};
+            for (int linha = 0; linha < tamanho; linha++)
+                for (int coluna = 0; coluna < tamanho; coluna++)
+                    if (reversi.at(linha, coluna) != 0) pecas[reversi.at(linha, coluna) - 1] |= ReversiBitboard::bit(linha, coluna);
+            for (int j = 1; j <= 2; j++) {
+                bool alguma = false;
+                if (tamanho == 8) {
+                    uint64_t esperada = ReversiBitboard::jogadas_validas(pecas[j - 1], pecas[2 - j]);
+                    if (reversi.mascara_jogadas(j) != esperada) divergencias++;
+                    alguma = esperada != 0;
+                } else {
+                    for (int linha = 0; linha < tamanho; linha++)
+                        for (int coluna = 0; coluna < tamanho; coluna++)
+                            alguma = alguma || reversi.verificar_jogada(linha, coluna, j);
+                }
+                if (reversi.tem_jogadas(j) != alguma) divergencias++;
+            }
+            if (reversi.tem_jogadas(jogador)) {
+                auto validas = reversi.atualizar_jogadas_validas(jogador);
+                std::vector<std::pair<int, int>> lista;
+                for (int linha = 0; linha < tamanho; linha++)
+                    for (int coluna = 0; coluna < tamanho; coluna++)
+                        if (validas[linha][coluna]) lista.push_back(std::make_pair(linha, coluna));
+                RegistroJogada registro;
+                std::pair<int, int> jogada = lista[(n * 5) % lista.size()];
+                REQUIRE(reversi.fazer_jogada(jogada.first, jogada.second, jogador, registro));
+                registros.push_back(registro);
+            }
+            jogador = (jogador == 1) ? 2 : 1;
+        }
+        CHECK(reversi.tem_jogadas(1) == false);
+        CHECK(reversi.tem_jogadas(2) == false);
+        while (!registros.empty()) {
+            reversi.desfazer_jogada(registros.back());
+            registros.pop_back();
+        }
+        CHECK(reversi.tem_jogadas(1) == true);
+        CHECK(reversi.get_tabuleiro() == Reversi(tamanho, tamanho).get_tabuleiro());
+        if (tamanho == 8) {
+            CHECK(reversi.mascara_jogadas(1) == (ReversiBitboard::bit(2, 3) | ReversiBitboard::bit(3, 2) |
+                                                 ReversiBitboard::bit(4, 5) | ReversiBitboard::bit(5, 4)));
+        } else {
+            CHECK_THROWS_AS(reversi.mascara_jogadas(1), std::logic_error); // Sem bitboard, sem máscara
+        }
+        CHECK(divergencias == 0);
+    }
+}
+
+TEST_CASE("Testando o perft") {
+    // Valores conhecidos a partir das posições iniciais (passar a vez conta como jogada no Reversi)
+    const long long reversi[] = {1, 4, 12, 56, 244, 1396, 8200};
+    const long long lig4[] = {1, 7, 49, 343, 2401, 16807, 117649, 823536};
+    for (int p = 0; p <= 6; p++) {
+        CHECK(Perft::reversi(Perft::REFERENCIA, p) == reversi[p]);
+        CHECK(Perft::reversi(Perft::TABULEIRO, p) == reversi[p]);
+        CHECK(Perft::reversi(Perft::BITS, p) == reversi[p]);
+    }
+    for (int p = 0; p <= 7; p++) {
+        CHECK(Perft::lig4(Perft::BITS, p) == lig4[p]);
+    }
+    CHECK(Perft::lig4(Perft::REFERENCIA, 6) == lig4[6]);
+    CHECK(Perft::lig4(Perft::TABULEIRO, 6) == lig4[6]);
+    CHECK(Perft::reversi(Perft::REFERENCIA, 5, 6) == Perft::reversi(Perft::TABULEIRO, 5, 6));
+
+    ThreadPool pool(2);
+    CHECK(Perft::paralelo(pool, "reversi", Perft::BITS, 7, 8, 8) == 55092);
+    CHECK(Perft::paralelo(pool, "reversi", Perft::REFERENCIA, 5, 8, 8) == 1396);
+    CHECK(Perft::paralelo(pool, "lig4", Perft::TABULEIRO, 6, 6, 7) == lig4[6]);
+    CHECK_THROWS_AS(Perft::paralelo(pool, "xadrez", Perft::BITS, 3, 8, 8), std::invalid_argument);
+}
+
+TEST_CASE("Testando o ReversiBitboard") {
+    Reversi reversi(8, 8);
+    ReversiBitboard bits;
+    bits.set_pecas(1, ReversiBitboard::bit(3, 4) | ReversiBitboard::bit(4, 3));
+    bits.set_pecas(2, ReversiBitboard::bit(3, 3) | ReversiBitboard::bit(4, 4));
+
+    SUBCASE("Testando jogadas_validas na posição inicial") {
+        uint64_t esperadas = ReversiBitboard::bit(2, 3) | ReversiBitboard::bit(3, 2) |
+                             ReversiBitboard::bit(4, 5) | ReversiBitboard::bit(5, 4);
+        CHECK(bits.jogadas_validas(1) == esperadas);
+    }
+
+    SUBCASE("Testando calcular_viradas, aplicar e desfazer") {
+        int indice = ReversiBitboard::indice(2, 3);
+        uint64_t viradas = bits.calcular_viradas(indice, 1);
+        CHECK(viradas == ReversiBitboard::bit(3, 3));
+        bits.aplicar(indice, 1, viradas);
+        CHECK(ReversiBitboard::contar(bits.pecas(1)) == 4);
+        CHECK(ReversiBitboard::contar(bits.pecas(2)) == 1);
+        bits.desfazer(indice, 1, viradas);
+        CHECK(bits.pecas(2) == (ReversiBitboard::bit(3, 3) | ReversiBitboard::bit(4, 4)));
+    }
+
+    SUBCASE("Testando Reversi 8x8 consistente com o bitboard") {
+        for (int i = 0; i < 8; i++) {
+            for (int j = 0; j < 8; j++) {
+                bool valida = (bits.jogadas_validas(1) >> ReversiBitboard::indice(i, j)) & 1;
+                CHECK(reversi.verificar_jogada(i, j, 1) == valida);
+            }
+        }
+        CHECK(reversi.ler_jogada(2, 3, 1) == 1);
+        CHECK(reversi.get_casa(3, 3) == 1);
+    }
+}
+
 TEST_CASE("Testando a classe JogoDaVelha") {
     JogoDaVelha jogo(3, 3);
 
@@ -186,6 +379,53 @@ TEST_CASE("Testando a classe JogoDaVelha") {
     }
 }
 
+TEST_CASE("Testando o JogoDaVelha m,n,k") {
+    SUBCASE("Cinco em linha num tabuleiro 15x15") {
+        JogoDaVelha jogo(15, 15, 5);
+        RegistroJogada registros[5];
+        for (int i = 0; i < 4; i++) {
+            jogo.fazer_jogada(3 + i, 10 - i, 1, registros[i]); // Diagonal secundária
+        }
+        CHECK(jogo.determinar_vencedor() == 0);
+        CHECK(jogo.testar_condicao_de_vitoria() == false);
+        jogo.fazer_jogada(7, 6, 1, registros[4]);
+        CHECK(jogo.determinar_vencedor() == 1);
+        CHECK(jogo.testar_condicao_de_vitoria() == true);
+        jogo.desfazer_jogada(registros[4]);
+        CHECK(jogo.determinar_vencedor() == 0);
+        CHECK_THROWS_AS(JogoDaVelha(3, 3, 4), std::invalid_argument);
+    }
+
+    SUBCASE("Empate com o tabuleiro cheio") {
+        JogoDaVelha jogo(2, 3, 3);
+        for (int j = 0; j < 3; j++) {
+            jogo.ler_jogada(0, j, 1 + j % 2);
+            jogo.ler_jogada(1, j, 2 - j % 2);
+        }
+        CHECK(jogo.testar_condicao_de_vitoria() == true);
+        CHECK(jogo.determinar_vencedor() == 0);
+        RegistroJogada registro = {1, 2, 1, 0, {}};
+        jogo.desfazer_jogada(registro);
+        CHECK(jogo.testar_condicao_de_vitoria() == false);
+        jogo.ler_jogada(1, 2, 1);
+        CHECK(jogo.testar_condicao_de_vitoria() == true);
+        CHECK(jogo.determinar_vencedor() == 0);
+    }
+
+    SUBCASE("JogoDaVelhaBot no gomoku completa ou bloqueia a quinta peça") {
+        JogoDaVelha jogo(15, 15, 5);
+        for (int j = 5; j < 9; j++) {
+            jogo.ler_jogada(7, j, 2);
+        }
+        jogo.ler_jogada(7, 4, 1);
+        jogo.ler_jogada(0, 0, 1);
+        jogo.ler_jogada(0, 1, 1);
+        JogoDaVelhaBot bot;
+        CHECK(bot.calcularProximaJogada(jogo, 1) == std::make_pair(7, 9));
+        CHECK(bot.calcularProximaJogada(jogo, 2) == std::make_pair(7, 9));
+    }
+}
+
 TEST_CASE("Testando a classe Lig4") {
     Lig4 lig4(6, 7);
 
@@ -211,4 +451,829 @@ TEST_CASE("Testando a classe Lig4") {
     }
 }
 
+TEST_CASE("Testando o vencedor incremental do Lig4 em tabuleiros grandes") {
+    // 9x12 não cabe no bitboard: o vencedor vem das linhas que passam pela última peça
+    Lig4 lig4(9, 12);
+    std::vector<RegistroJogada> registros;
+    int jogador = 1, divergencias = 0;
+    for (int n = 0; !lig4.testar_condicao_de_vitoria(); n++) {
+        int coluna = (n * 5 + n / 7) % 12;
+        while (!lig4.verificar_jogada(0, coluna, jogador)) coluna = (coluna + 1) % 12;
+        RegistroJogada registro;
+        REQUIRE(lig4.fazer_jogada(0, coluna, jogador, registro));
+        registros.push_back(registro);
+        if (lig4.determinar_vencedor() != lig4.vencedor_por_varredura()) divergencias++;
+        jogador = (jogador == 1) ? 2 : 1;
+    }
+    CHECK(lig4.determinar_vencedor() != 0);
+    // Desfazendo tudo, o vencedor guardado continua conferindo com a varredura
+    while (!registros.empty()) {
+        lig4.desfazer_jogada(registros.back());
+        registros.pop_back();
+        if (lig4.determinar_vencedor() != lig4.vencedor_por_varredura()) divergencias++;
+    }
+    CHECK(divergencias == 0);
+    CHECK(lig4.testar_condicao_de_vitoria() == false);
+}
+
+TEST_CASE("Testando o Lig4Bitboard") {
+    Lig4Bitboard bits(6, 7);
+
+    SUBCASE("Testando jogar e pode_jogar") {
+        CHECK(bits.jogar(3, 1) == 0);
+        CHECK(bits.jogar(3, 2) == 1);
+        for (int i = 2; i < 6; ++i) {
+            bits.jogar(3, 1);
+        }
+        CHECK(bits.pode_jogar(3) == false);
+        CHECK(bits.pode_jogar(2) == true);
+    }
+
+    SUBCASE("Testando alinhamentos") {
+        for (int coluna = 0; coluna < 3; ++coluna) {
+            bits.jogar(coluna, 1);
+        }
+        CHECK(bits.vencedor() == 0);
+        bits.jogar(3, 1);
+        CHECK(bits.vencedor() == 1);
+    }
+
+    SUBCASE("Testando que a sentinela impede vitórias entre colunas") {
+        // Peças no topo da coluna 0 e no fundo da coluna 1 não são consecutivas
+        for (int i = 0; i < 6; ++i) {
+            bits.jogar(0, i < 3 ? 2 : 1);
+        }
+        bits.jogar(1, 1);
+        CHECK(bits.vencedor() == 0);
+    }
+
+    SUBCASE("Testando desfazer") {
+        bits.jogar(0, 1);
+        bits.jogar(0, 2);
+        bits.desfazer(0);
+        CHECK(bits.pecas(2) == 0);
+        CHECK(bits.jogar(0, 2) == 1);
+    }
+}
+
+TEST_CASE("Testando fazer_jogada e desfazer_jogada") {
+    SUBCASE("Reversi 8x8") {
+        Reversi reversi(8, 8);
+        auto original = reversi.get_tabuleiro();
+        RegistroJogada registro;
+        CHECK(reversi.fazer_jogada(2, 3, 1, registro) == true);
+        CHECK(reversi.get_casa(3, 3) == 1);
+        reversi.desfazer_jogada(registro);
+        CHECK(reversi.get_tabuleiro() == original);
+        CHECK(reversi.verificar_jogada(2, 3, 1) == true);
+        CHECK(reversi.fazer_jogada(0, 0, 1, registro) == false);
+    }
+
+    SUBCASE("Reversi com tamanho diferente de 8x8") {
+        Reversi reversi(6, 6);
+        auto original = reversi.get_tabuleiro();
+        RegistroJogada registro;
+        CHECK(reversi.fazer_jogada(1, 2, 1, registro) == true);
+        reversi.desfazer_jogada(registro);
+        CHECK(reversi.get_tabuleiro() == original);
+    }
+
+    SUBCASE("Lig4") {
+        Lig4 lig4(6, 7);
+        RegistroJogada primeiro, segundo;
+        CHECK(lig4.fazer_jogada(0, 3, 1, primeiro) == true);
+        CHECK(lig4.fazer_jogada(0, 3, 2, segundo) == true);
+        CHECK(segundo.linha == 4);
+        lig4.desfazer_jogada(segundo);
+        CHECK(lig4.get_casa(4, 3) == 0);
+        CHECK(lig4.ler_jogada(0, 3, 2) == 4);
+    }
+
+    SUBCASE("JogoDaVelha") {
+        JogoDaVelha jogo(3, 3);
+        RegistroJogada registro;
+        CHECK(jogo.fazer_jogada(1, 1, 1, registro) == true);
+        CHECK(jogo.fazer_jogada(1, 1, 2, registro) == false);
+        jogo.desfazer_jogada(registro);
+        CHECK(jogo.get_casa(1, 1) == 0);
+    }
+}
+
+TEST_CASE("Testando o armazenamento contíguo das casas") {
+    SUBCASE("Visão somente leitura e acesso sem verificação") {
+        Reversi reversi(8, 8);
+        VisaoTabuleiro visao = reversi.visao();
+        CHECK(visao.linhas == 8);
+        CHECK(visao.colunas == 8);
+        CHECK(visao(3, 3) == 2);
+        CHECK(visao.celulas[3 * 8 + 4] == 1);
+        CHECK(reversi.at(4, 3) == 1);
+        reversi.ler_jogada(2, 3, 1);
+        CHECK(visao(3, 3) == 1); // A visão reflete o estado atual, sem cópia
+    }
+
+    SUBCASE("Tabuleiros maiores que a capacidade local") {
+        Lig4 lig4(10, 12);
+        CHECK(lig4.ler_jogada(0, 11, 2) == 9);
+        CHECK(lig4.at(9, 11) == 2);
+        Lig4 copia = lig4;
+        copia.ler_jogada(0, 11, 1);
+        CHECK(copia.at(8, 11) == 1);
+        CHECK(lig4.at(8, 11) == 0);
+        CHECK(lig4.get_casa(10, 0) == 'F');
+    }
+}
+
+TEST_CASE("Testando os bots com busca alfa-beta") {
+    SUBCASE("JogoDaVelhaBot completa a linha vencedora") {
+        JogoDaVelha jogo(3, 3);
+        jogo.ler_jogada(0, 0, 2);
+        jogo.ler_jogada(0, 1, 2);
+        jogo.ler_jogada(1, 1, 1);
+        jogo.ler_jogada(2, 2, 1);
+        JogoDaVelhaBot bot;
+        CHECK(bot.calcularProximaJogada(jogo, 2) == std::make_pair(0, 2));
+        CHECK(bot.getNosVisitados() > 0);
+    }
+
+    SUBCASE("JogoDaVelhaBot contra ele mesmo empata") {
+        JogoDaVelha jogo(3, 3);
+        JogoDaVelhaBot bot;
+        int jogador = 1;
+        while (!jogo.testar_condicao_de_vitoria()) {
+            std::pair<int, int> jogada = bot.calcularProximaJogada(jogo, jogador);
+            jogo.ler_jogada(jogada.first, jogada.second, jogador);
+            jogador = (jogador == 1) ? 2 : 1;
+        }
+        CHECK(jogo.determinar_vencedor() == 0);
+    }
+
+    SUBCASE("Lig4Bot bloqueia a vitória do oponente") {
+        Lig4 lig4(6, 7);
+        lig4.ler_jogada(0, 0, 1);
+        lig4.ler_jogada(0, 1, 1);
+        lig4.ler_jogada(0, 2, 1);
+        lig4.ler_jogada(0, 6, 2);
+        lig4.ler_jogada(0, 6, 2);
+        Lig4Bot bot(5);
+        CHECK(bot.calcularProximaJogada(lig4, 2) == std::make_pair(0, 3));
+    }
+
+    SUBCASE("ReversiBot não altera o tabuleiro recebido e retorna jogada válida") {
+        Reversi reversi(8, 8);
+        auto original = reversi.get_tabuleiro();
+        ReversiBot bot(4);
+        std::pair<int, int> jogada = bot.calcularProximaJogada(reversi, 1);
+        CHECK(reversi.verificar_jogada(jogada.first, jogada.second, 1) == true);
+        CHECK(reversi.get_tabuleiro() == original);
+    }
+}
+
+TEST_CASE("Testando o hash Zobrist e a tabela de transposição") {
+    SUBCASE("Hash incremental volta ao original ao desfazer") {
+        Reversi reversi(8, 8);
+        uint64_t inicial = reversi.get_hash();
+        CHECK(inicial != 0);
+        RegistroJogada registro;
+        reversi.fazer_jogada(2, 3, 1, registro);
+        CHECK(reversi.get_hash() != inicial);
+        reversi.desfazer_jogada(registro);
+        CHECK(reversi.get_hash() == inicial);
+    }
+
+    SUBCASE("Transposições têm o mesmo hash") {
+        Lig4 a(6, 7), b(6, 7);
+        a.ler_jogada(0, 1, 1);
+        a.ler_jogada(0, 5, 2);
+        a.ler_jogada(0, 3, 1);
+        b.ler_jogada(0, 3, 1);
+        b.ler_jogada(0, 5, 2);
+        b.ler_jogada(0, 1, 1);
+        CHECK(a.get_hash() == b.get_hash());
+    }
+
+    SUBCASE("Guardar e consultar entradas") {
+        TabelaTransposicao tabela(1);
+        CHECK(tabela.getEntradas() > 0);
+        EntradaTT entrada;
+        CHECK(tabela.consultar(12345, entrada) == false);
+        tabela.guardar(12345, 5, -42, EntradaTT::EXATA, 2, 3);
+        REQUIRE(tabela.consultar(12345, entrada) == true);
+        CHECK(entrada.pontuacao == -42);
+        CHECK(entrada.profundidade == 5);
+        CHECK(entrada.tipo() == EntradaTT::EXATA);
+        CHECK(entrada.linha == 2);
+        CHECK(entrada.coluna == 3);
+        tabela.limpar();
+        CHECK(tabela.consultar(12345, entrada) == false);
+    }
+}
+
+TEST_CASE("Testando o aprofundamento iterativo com limites") {
+    SUBCASE("Orçamento de nós") {
+        Lig4 lig4(6, 7);
+        Lig4Bot bot;
+        std::pair<int, int> jogada = bot.calcularProximaJogada(lig4, 1, LimiteBusca::porNos(3000));
+        CHECK(lig4.verificar_jogada(jogada.first, jogada.second, 1) == true);
+        CHECK(bot.getNosVisitados() <= 3000 + 256);
+        CHECK(bot.getProfundidadeAlcancada() >= 1);
+    }
+
+    SUBCASE("Prazo por jogada") {
+        Reversi reversi(8, 8);
+        ReversiBot bot;
+        LimiteBusca::Relogio::time_point inicio = LimiteBusca::Relogio::now();
+        std::pair<int, int> jogada = bot.calcularProximaJogada(reversi, 1, LimiteBusca::porTempo(std::chrono::milliseconds(20)));
+        CHECK(LimiteBusca::Relogio::now() - inicio < std::chrono::milliseconds(200));
+        CHECK(reversi.verificar_jogada(jogada.first, jogada.second, 1) == true);
+    }
+
+    SUBCASE("Limite por profundidade") {
+        JogoDaVelha jogo(3, 3);
+        JogoDaVelhaBot bot;
+        bot.calcularProximaJogada(jogo, 1, LimiteBusca::porProfundidade(2));
+        CHECK(bot.getProfundidadeAlcancada() == 2);
+    }
+}
+
+/// Minimax simples do Jogo da Velha 3x3 (casas 0..8), na mesma escala da TabelaVelha.
+static int valorVelhaBruto(int* casas, int jogador, int pecas) {
+    const int linhas[8][3] = {{0, 1, 2}, {3, 4, 5}, {6, 7, 8}, {0, 3, 6}, {1, 4, 7}, {2, 5, 8}, {0, 4, 8}, {2, 4, 6}};
+    for (const auto& l : linhas) {
+        if (casas[l[0]] != 0 && casas[l[0]] == casas[l[1]] && casas[l[0]] == casas[l[2]]) {
+            return casas[l[0]] == jogador ? 10 - pecas : pecas - 10;
+        }
+    }
+    if (pecas == 9) return 0;
+    int melhor = -100;
+    for (int i = 0; i < 9; i++) {
+        if (casas[i] != 0) continue;
+        casas[i] = jogador;
+        melhor = std::max(melhor, -valorVelhaBruto(casas, 3 - jogador, pecas + 1));
+        casas[i] = 0;
+    }
+    return melhor;
+}
+
+TEST_CASE("Testando a tabela perfeita do Jogo da Velha") {
+    SUBCASE("Valores conferem com o minimax em todas as posições alcançáveis") {
+        int casas[9] = {};
+        int codigo = 0, pecas = 0, diferentes = 0;
+        // Percorre as posições com o jogador 1 começando; cada código visitado mais de uma vez não importa
+        std::vector<int> pilha(1, 0);
+        std::vector<bool> visto(TabelaVelha::POSICOES, false);
+        while (!pilha.empty()) {
+            codigo = pilha.back();
+            pilha.pop_back();
+            if (visto[codigo]) continue;
+            visto[codigo] = true;
+            pecas = 0;
+            for (int i = 0, resto = codigo; i < 9; i++, resto /= 3) {
+                casas[i] = resto % 3;
+                if (casas[i] != 0) pecas++;
+            }
+            int jogador = (pecas % 2 == 0) ? 1 : 2;
+            const JogadaVelha& entrada = tabelaVelha().consultar(codigo, jogador);
+            if (entrada.valor != valorVelhaBruto(casas, jogador, pecas)) diferentes++;
+            if (entrada.casa < 0) continue;
+            int potencia = 1;
+            for (int i = 0; i < 9; i++, potencia *= 3) {
+                if (casas[i] == 0) pilha.push_back(codigo + jogador * potencia);
+            }
+        }
+        CHECK(diferentes == 0);
+        CHECK(tabelaVelha().consultar(0, 1).valor == 0);
+    }
+
+    SUBCASE("JogoDaVelhaBot usa a tabela e bloqueia o oponente") {
+        JogoDaVelha jogo(3, 3);
+        jogo.ler_jogada(1, 1, 1);
+        jogo.ler_jogada(0, 0, 2);
+        jogo.ler_jogada(2, 0, 1);
+        JogoDaVelhaBot bot;
+        CHECK(bot.calcularProximaJogada(jogo, 2) == std::make_pair(0, 2));
+        CHECK(bot.getNosVisitados() == 1);
+        CHECK(bot.getProfundidadeAlcancada() == 6);
+    }
+}
+
+TEST_CASE("Testando a busca paralela do ReversiBot") {
+    ThreadPool pool(3);
+    CHECK(pool.getThreads() == 3);
+
+    SUBCASE("Tarefas do pool") {
+        std::atomic<int> soma(0);
+        std::vector<std::future<void>> futuros;
+        for (int i = 1; i <= 100; i++) {
+            futuros.push_back(pool.enviar([&soma, i]() { soma += i; }));
+        }
+        for (auto& futuro : futuros) futuro.get();
+        CHECK(soma == 5050);
+    }
+
+    SUBCASE("Jogada válida com várias threads") {
+        Reversi reversi(8, 8);
+        ReversiBot bot(4, &pool);
+        CHECK(bot.getThreads() == 4);
+        std::pair<int, int> jogada = bot.calcularProximaJogada(reversi, 1);
+        CHECK(reversi.verificar_jogada(jogada.first, jogada.second, 1) == true);
+        CHECK(bot.getProfundidadeAlcancada() >= 4);
+    }
+}
+
+TEST_CASE("Testando o MCTSReversiBot") {
+    Reversi reversi(8, 8);
+
+    SUBCASE("Orçamento de simulações") {
+        MCTSReversiBot bot(800);
+        std::pair<int, int> jogada = bot.calcularProximaJogada(reversi, 1);
+        CHECK(reversi.verificar_jogada(jogada.first, jogada.second, 1) == true);
+        CHECK(bot.getNosVisitados() == 800);
+        CHECK(bot.getProfundidadeAlcancada() >= 2);
+    }
+
+    SUBCASE("Simulações em paralelo com arena pequena") {
+        ThreadPool pool(3);
+        MCTSReversiBot bot(2000, &pool, 64);
+        std::pair<int, int> jogada = bot.calcularProximaJogada(reversi, 2);
+        CHECK(reversi.verificar_jogada(jogada.first, jogada.second, 2) == true);
+        CHECK(bot.getNosVisitados() == 2000);
+    }
+
+    SUBCASE("Solução exata do final com prazo") {
+        // Com o limiar no começo do jogo a solução exata estoura o prazo e valem as simulações
+        MCTSReversiBot bot(300);
+        bot.setLimiarFinal(60);
+        bot.setPrazoFinal(std::chrono::milliseconds(20));
+        std::pair<int, int> jogada = bot.calcularProximaJogada(reversi, 1);
+        CHECK(reversi.verificar_jogada(jogada.first, jogada.second, 1) == true);
+        CHECK(bot.getNosVisitados() == 300);
 
+        // Com prazo na jogada, a solução exata fica com metade e as simulações com o resto
+        LimiteBusca::Relogio::time_point inicio = LimiteBusca::Relogio::now();
+        jogada = bot.calcularProximaJogada(reversi, 1, LimiteBusca::porTempo(std::chrono::milliseconds(100)));
+        CHECK(LimiteBusca::Relogio::now() - inicio < std::chrono::seconds(1));
+        CHECK(reversi.verificar_jogada(jogada.first, jogada.second, 1) == true);
+        CHECK(bot.getNosVisitados() > 0);
+    }
+
+    SUBCASE("Dificuldade inválida") {
+        Jogador jogador("Teste", "teste");
+        Partida partida(3, &jogador);
+        CHECK(partida.iniciarPartida(0) == false);
+    }
+}
+
+/// Valor exato por força bruta (sem poda), para conferir o solucionador de finais.
+static int valorFinalBruto(uint64_t proprias, uint64_t oponente, bool passou) {
+    uint64_t jogadas = ReversiBitboard::jogadas_validas(proprias, oponente);
+    if (jogadas == 0) {
+        if (passou) return ReversiBitboard::contar(proprias) - ReversiBitboard::contar(oponente);
+        return -valorFinalBruto(oponente, proprias, true);
+    }
+    int melhor = -65;
+    for (; jogadas; jogadas &= jogadas - 1) {
+        int casa = __builtin_ctzll(jogadas);
+        uint64_t viradas = ReversiBitboard::calcular_viradas(casa, proprias, oponente);
+        melhor = std::max(melhor, -valorFinalBruto(oponente & ~viradas, proprias | viradas | (1ULL << casa), false));
+    }
+    return melhor;
+}
+
+TEST_CASE("Testando a solução exata dos finais de Reversi") {
+    // Partida determinística até restarem 9 casas vazias
+    Reversi reversi(8, 8);
+    int jogador = 1;
+    for (int n = 0; n < 51; n++) {
+        std::vector<std::pair<int, int>> validas;
+        for (int linha = 0; linha < 8; linha++)
+            for (int coluna = 0; coluna < 8; coluna++)
+                if (reversi.verificar_jogada(linha, coluna, jogador)) validas.push_back(std::make_pair(linha, coluna));
+        if (!validas.empty()) {
+            std::pair<int, int> jogada = validas[(n * 7) % validas.size()];
+            reversi.ler_jogada(jogada.first, jogada.second, jogador);
+        }
+        jogador = (jogador == 1) ? 2 : 1;
+    }
+
+    uint64_t pecas[2] = {0, 0};
+    for (int linha = 0; linha < 8; linha++)
+        for (int coluna = 0; coluna < 8; coluna++)
+            if (reversi.at(linha, coluna) != 0) pecas[reversi.at(linha, coluna) - 1] |= ReversiBitboard::bit(linha, coluna);
+    uint64_t proprias = pecas[jogador - 1], oponente = pecas[2 - jogador];
+    REQUIRE(ReversiBitboard::jogadas_validas(proprias, oponente) != 0);
+
+    ContextoBusca contexto;
+    SolucionadorFinalReversi solucionador(contexto);
+    int casa;
+    int valor = solucionador.resolver(proprias, oponente, casa);
+    CHECK(valor == valorFinalBruto(proprias, oponente, false));
+
+    ReversiBot bot;
+    std::pair<int, int> jogada = bot.calcularProximaJogada(reversi, jogador);
+    REQUIRE(reversi.verificar_jogada(jogada.first, jogada.second, jogador) == true);
+    int indice = ReversiBitboard::indice(jogada.first, jogada.second);
+    uint64_t viradas = ReversiBitboard::calcular_viradas(indice, proprias, oponente);
+    CHECK(-valorFinalBruto(oponente & ~viradas, proprias | viradas | (1ULL << indice), false) == valor);
+    CHECK(bot.getProfundidadeAlcancada() == ReversiBitboard::contar(~(proprias | oponente)));
+
+    // Sem prazo na jogada, a solução exata tem o prazo do bot; estourado, vale a busca normal
+    ReversiBot limitado(2);
+    limitado.setLimiarFinal(60);
+    limitado.setPrazoFinal(std::chrono::milliseconds(20));
+    Reversi inicio(8, 8);
+    LimiteBusca::Relogio::time_point comeco = LimiteBusca::Relogio::now();
+    jogada = limitado.calcularProximaJogada(inicio, 1);
+    CHECK(LimiteBusca::Relogio::now() - comeco < std::chrono::seconds(2));
+    CHECK(inicio.verificar_jogada(jogada.first, jogada.second, 1) == true);
+    CHECK(limitado.getProfundidadeAlcancada() == 2);
+}
+
+TEST_CASE("Testando o modo perfeito do Lig4") {
+    Lig4 lig4(6, 7);
+    Lig4Bot bot;
+    bot.setModoPerfeito(true, std::chrono::milliseconds(200)); // No começo do jogo o prazo estoura e vale a busca heurística
+
+    SUBCASE("Bloqueia a ameaça e depois vence") {
+        // Jogador 2 ameaça completar a linha de baixo na coluna 0 (a coluna 4 já é do jogador 1)
+        lig4.ler_jogada(0, 1, 2);
+        lig4.ler_jogada(0, 4, 1);
+        lig4.ler_jogada(0, 2, 2);
+        lig4.ler_jogada(0, 6, 1);
+        lig4.ler_jogada(0, 3, 2);
+        std::pair<int, int> jogada = bot.calcularProximaJogada(lig4, 1);
+        CHECK(jogada.second == 0);
+
+        // Jogador 1 com três peças na coluna 5: a vitória imediata vale (43 - peças) / 2
+        Lig4 vitoria(6, 7);
+        for (int i = 0; i < 3; i++) {
+            vitoria.ler_jogada(0, 5, 1);
+            vitoria.ler_jogada(0, i, 2);
+        }
+        CHECK(bot.calcularProximaJogada(vitoria, 1).second == 5);
+        CHECK(bot.getProfundidadeAlcancada() == 42 - 6);
+    }
+
+    SUBCASE("Tabela de abertura") {
+        SolucionadorLig4 solucionador;
+        CHECK(solucionador.carregarAbertura("arquivo_que_nao_existe.txt") == false);
+
+        const char* caminho = "abertura_teste.txt";
+        {
+            std::ofstream arquivo(caminho);
+            arquivo << "- 1\n4 -1\n44 1\n";
+        }
+        CHECK(solucionador.carregarAbertura(caminho) == true);
+        CHECK(solucionador.getTamanhoAbertura() == 3);
+        {
+            std::ofstream arquivo(caminho);
+            arquivo << "48 0\n";
+        }
+        CHECK_THROWS_AS(solucionador.carregarAbertura(caminho), std::invalid_argument);
+        std::remove(caminho);
+    }
+}
+
+TEST_CASE("Testando a arena") {
+    ConfiguracaoBot bot = ConfiguracaoBot::ler("alfabeta:5");
+    CHECK(bot.tipo == "alfabeta");
+    CHECK(bot.nivel == 5);
+    CHECK(ConfiguracaoBot::ler("perfeito").texto() == "perfeito");
+    CHECK_THROWS_AS(ConfiguracaoBot::ler("minimax:3"), std::invalid_argument);
+    CHECK_THROWS_AS(ConfiguracaoBot::ler("mcts:"), std::invalid_argument);
+
+    ResultadoArena resultado;
+    resultado.vitorias = 3;
+    resultado.derrotas = 1;
+    CHECK(resultado.pontuacao() == doctest::Approx(0.75));
+    CHECK(resultado.elo() == doctest::Approx(190.85).epsilon(0.001));
+    CHECK(resultado.erroElo() > 0.0);
+    resultado.derrotas = 0; // 100%: Elo finito
+    CHECK(resultado.elo() > 0.0);
+
+    ConfiguracaoArena configuracao;
+    configuracao.tipoJogo = 3;
+    configuracao.bots[0] = ConfiguracaoBot::ler("perfeito");
+    CHECK_THROWS_AS(Arena arena(configuracao), std::invalid_argument);
+    configuracao.tipoJogo = 2;
+    configuracao.bots[0] = ConfiguracaoBot::ler("mcts:100");
+    CHECK_THROWS_AS(Arena arena(configuracao), std::invalid_argument);
+    configuracao.tipoJogo = 3;
+    configuracao.bots[0] = ConfiguracaoBot::ler("alfabeta:2");
+    configuracao.linhas = 6;
+    configuracao.colunas = 8;
+    CHECK_THROWS_AS(Arena arena(configuracao), std::invalid_argument); // Reversi só quadrado
+    configuracao.linhas = configuracao.colunas = 0;
+
+    // As soluções exatas da arena são limitadas por nós, não pelo relógio
+    std::unique_ptr<BotPlayer> lig4 = Arena::criarBot(2, ConfiguracaoBot::ler("perfeito"));
+    CHECK(dynamic_cast<Lig4Bot&>(*lig4).getNosPerfeito() > 0);
+    std::unique_ptr<BotPlayer> mcts = Arena::criarBot(3, ConfiguracaoBot::ler("mcts:100"));
+    CHECK(dynamic_cast<ReversiBot&>(*mcts).getNosFinal() > 0);
+
+    SUBCASE("Jogo da Velha perfeito contra perfeito empata sempre") {
+        configuracao.tipoJogo = 1;
+        configuracao.bots[0] = configuracao.bots[1] = ConfiguracaoBot::ler("perfeito");
+        configuracao.aberturaAleatoria = 0;
+        configuracao.partidas = 6;
+        ResultadoArena velha = Arena(configuracao).executar();
+        CHECK(velha.empates == 6);
+        CHECK(velha.elo() == doctest::Approx(0.0));
+    }
+
+    SUBCASE("O placar não depende do número de threads") {
+        configuracao.tipoJogo = 2;
+        configuracao.bots[0] = ConfiguracaoBot::ler("alfabeta:5");
+        configuracao.bots[1] = ConfiguracaoBot::ler("alfabeta:1");
+        configuracao.partidas = 8;
+        ResultadoArena sozinho = Arena(configuracao).executar();
+        configuracao.threads = 3;
+        ResultadoArena paralelo = Arena(configuracao).executar();
+        CHECK(sozinho.partidas() == 8);
+        CHECK(sozinho.vitorias > sozinho.derrotas);
+        CHECK(paralelo.vitorias == sozinho.vitorias);
+        CHECK(paralelo.empates == sozinho.empates);
+        CHECK(paralelo.derrotas == sozinho.derrotas);
+    }
+}
+
+TEST_CASE("Testando o modo em lote") {
+    const char* caminho = "cadastro_lote_teste.txt";
+    Cadastro jogadores;
+    jogadores.setVerboso(false);
+    Lote lote(jogadores, caminho);
+
+    std::istringstream entrada(
+        "CJ ana Ana Maria\n"
+        "CJ beto Beto\n"
+        "\n"
+        "# Velha: ana completa a primeira coluna\n"
+        "EP V ana beto 1 1 1 2 2 1 2 2 3 1\n"
+        "EP L beto ana 1 2 1 2 1 2 1\n"
+        "EP R ana beto 4 3\n"
+        "EP V ana ana 1 1\n"
+        "CJ ana Outra\n"
+        "LJ\n");
+    std::ostringstream saida;
+    CHECK(lote.executar(entrada, saida) == 3);
+    CHECK(lote.getComandos() == 8);
+    CHECK(saida.str().find("Erro na linha 7: Partida incompleta") != std::string::npos);
+    CHECK(saida.str().find("Ana Maria,ana,1,0,0,1,0,0\nBeto,beto,0,1,1,0,0,0\n") != std::string::npos);
+
+    // O cadastro é salvo uma vez, no fim
+    Cadastro salvo;
+    salvo.setVerboso(false);
+    salvo.import(caminho);
+    REQUIRE(salvo.get_jogadores().size() == 2);
+    CHECK(salvo.get_jogadores()[0]->serializar() == "Ana Maria,ana,1,0,0,1,0,0");
+    std::remove(caminho);
+}
+
+TEST_CASE("Testando o diário do Cadastro") {
+    const std::string caminho = "cadastro_diario_teste.txt";
+    const std::string diario = Cadastro::caminhoDiario(caminho);
+    std::remove(caminho.c_str());
+    std::remove(diario.c_str());
+
+    {
+        Cadastro cadastro;
+        cadastro.setVerboso(false);
+        cadastro.abrirDiario(caminho);
+        cadastro.adicionarJogador(Jogador("Ana", "ana"));
+        cadastro.adicionarJogador(Jogador("Beto", "beto"));
+        cadastro.adicionarJogador(Jogador("Caio", "caio"));
+        cadastro.removeJogador(Jogador("", "beto"));
+        Jogador* ana = cadastro.find("ana");
+        ana->setVitorias(ana->getReversi(), 3);
+        cadastro.registrarAlteracao(*ana);
+        CHECK(cadastro.getRegistrosDiario() == 5);
+    }
+    {
+        // Sem arquivo principal: tudo vem do diário, com uma escrita interrompida no fim
+        std::ofstream(diario, std::ios::app) << "+,Davi,da";
+        Cadastro cadastro;
+        cadastro.setVerboso(false);
+        cadastro.import(caminho);
+        CHECK(cadastro.get_jogadores().size() == 2);
+        CHECK(cadastro.find("beto") == nullptr);
+        REQUIRE(cadastro.find("ana") != nullptr);
+        CHECK(cadastro.find("ana")->serializar() == "Ana,ana,0,0,0,0,3,0");
+        CHECK(cadastro.getRegistrosDiario() == 5);
+
+        // Compactar grava o arquivo principal e esvazia o diário
+        cadastro.abrirDiario(caminho);
+        cadastro.compactar();
+        CHECK(cadastro.getRegistrosDiario() == 0);
+        std::ifstream vazio(diario);
+        CHECK(vazio.peek() == std::ifstream::traits_type::eof());
+        cadastro.adicionarJogador(Jogador("Eva", "eva"));
+    }
+    {
+        // Aplicar de novo um diário já contido no arquivo principal não muda o resultado
+        std::ofstream(diario, std::ios::app) << "=,Ana,ana,0,0,0,0,3,0\n-,beto\n";
+        Cadastro cadastro;
+        cadastro.setVerboso(false);
+        cadastro.import(caminho);
+        CHECK(cadastro.get_jogadores().size() == 3);
+        CHECK(cadastro.check(Jogador("", "eva")));
+
+        std::ofstream(diario, std::ios::app) << "?,lixo\n";
+        CHECK_THROWS_WITH_AS(cadastro.import(caminho), doctest::Contains("diário, linha 4"), std::runtime_error);
+    }
+    {
+        // Registro incompleto seguido de novos registros, sem compactar: o resto cortado não se junta a eles
+        std::remove(caminho.c_str());
+        std::ofstream(diario, std::ios::trunc) << "+,Ana,ana,0,0,0,0,0,0\n=,Ana,ana,1,0,0";
+        Cadastro cadastro;
+        cadastro.setVerboso(false);
+        cadastro.import(caminho);
+        CHECK(cadastro.get_jogadores().size() == 1);
+        cadastro.abrirDiario(caminho);
+        cadastro.adicionarJogador(Jogador("Bia", "bia"));
+        cadastro.import(caminho);
+        CHECK(cadastro.get_jogadores().size() == 2);
+        CHECK(cadastro.check(Jogador("", "bia")));
+        CHECK(cadastro.find("ana")->serializar() == "Ana,ana,0,0,0,0,0,0");
+
+        // Sem nenhum registro completo, o diário inteiro é descartado
+        std::ofstream(diario, std::ios::trunc) << "+,Ca";
+        cadastro.abrirDiario(caminho);
+        cadastro.adicionarJogador(Jogador("Caio", "caio"));
+        cadastro.import(caminho);
+        CHECK(cadastro.get_jogadores().size() == 1);
+        CHECK(cadastro.check(Jogador("", "caio")));
+    }
+    std::remove(caminho.c_str());
+    std::remove(diario.c_str());
+}
+
+TEST_CASE("Testando a gravação atômica e a sincronização em grupo do Cadastro") {
+    const std::string caminho = "cadastro_grupo_teste.txt";
+    const std::string diario = Cadastro::caminhoDiario(caminho);
+    std::remove(caminho.c_str());
+    std::remove(diario.c_str());
+
+    {
+        Cadastro cadastro;
+        cadastro.setVerboso(false);
+        cadastro.adicionarJogador(Jogador("Ana", "ana"));
+        cadastro.save(caminho);
+        CHECK(std::ifstream(caminho + ".tmp").is_open() == false);
+
+        // Sem conseguir criar o temporário, a gravação falha sem deixar nada pela metade
+        cadastro.adicionarJogador(Jogador("Beto", "beto"));
+        CHECK_THROWS_AS(cadastro.save("diretorio_que_nao_existe/cadastro.txt"), std::runtime_error);
+
+        cadastro.abrirDiario(caminho);
+        cadastro.setIntervaloSincronizacao(std::chrono::milliseconds(50));
+        Jogador* ana = cadastro.find("ana");
+        for (int i = 1; i <= 200; i++) {
+            ana->setVitorias(ana->getVelha(), i);
+            cadastro.registrarAlteracao(*ana);
+        }
+        cadastro.sincronizar();
+        CHECK(cadastro.getSincronizacoes() >= 1);
+        CHECK(cadastro.getSincronizacoes() < 50); // Os registros vão juntos para o disco
+        ana->setVitorias(ana->getVelha(), 500);
+        cadastro.registrarAlteracao(*ana); // Fica pendente: o destrutor grava antes de fechar
+    }
+
+    Cadastro lido;
+    lido.setVerboso(false);
+    lido.import(caminho);
+    CHECK(lido.get_jogadores().size() == 1);
+    REQUIRE(lido.find("ana") != nullptr);
+    CHECK(lido.find("ana")->getVitorias(lido.find("ana")->getVelha()) == 500);
+    std::remove(caminho.c_str());
+    std::remove(diario.c_str());
+}
+
+TEST_CASE("Testando a importação em paralelo do Cadastro") {
+    const std::string caminho = "cadastro_paralelo_teste.txt";
+    auto gravar = [&caminho](int linhas, int linhaRuim, const std::string& conteudoRuim) {
+        std::ofstream arquivo(caminho);
+        for (int i = 1; i <= linhas; i++) {
+            if (i == linhaRuim) {
+                arquivo << conteudoRuim << "\n";
+            } else if (i % 1000 == 0) {
+                arquivo << "\n"; // Linhas vazias também contam na numeração
+            } else {
+                arquivo << "Jogador " << i << ",j" << i << "," << i % 7 << ",1,2,3,4,5\n";
+            }
+        }
+    };
+    ThreadPool pool(3);
+
+    // Arquivo grande o bastante para ser dividido em vários pedaços
+    gravar(30000, 0, "");
+    Cadastro serial, paralelo;
+    serial.setVerboso(false);
+    paralelo.setVerboso(false);
+    serial.import(caminho);
+    paralelo.import(caminho, pool);
+    REQUIRE(paralelo.get_jogadores().size() == serial.get_jogadores().size());
+    CHECK(paralelo.get_jogadores().size() == 29970);
+    bool iguais = true;
+    for (std::size_t i = 0; i < serial.get_jogadores().size(); i++) {
+        iguais = iguais && serial.get_jogadores()[i]->serializar() == paralelo.get_jogadores()[i]->serializar();
+    }
+    CHECK(iguais);
+    CHECK(paralelo.find("j29999") != nullptr);
+
+    // Os erros trazem o mesmo número de linha da leitura linha a linha
+    gravar(30000, 21234, "Quebrado,q,1,2");
+    CHECK_THROWS_WITH(paralelo.import(caminho, pool),
+                      "Erro na importação: Erro na linha 21234: Erro na deserialização: "
+                      "Formato inválido na string de entrada: esperado 8 campos, encontrado 4");
+    CHECK(paralelo.get_jogadores().empty());
+    gravar(30000, 25001, "Repetido,j7,0,0,0,0,0,0");
+    CHECK_THROWS_WITH(paralelo.import(caminho, pool), "Erro na importação: Erro na linha 25001: Apelido repetido: j7");
+    CHECK_THROWS_WITH(serial.import(caminho), "Erro na importação: Erro na linha 25001: Apelido repetido: j7");
+
+    // Arquivo ausente: cadastro vazio, como no import de uma thread
+    std::remove(caminho.c_str());
+    paralelo.import(caminho, pool);
+    CHECK(paralelo.get_jogadores().empty());
+}
+
+TEST_CASE("Testando o formato binário do Cadastro") {
+    const std::string texto = "cadastro_binario_teste.txt";
+    const std::string binario = "cadastro_binario_teste.bin";
+    {
+        std::ofstream arquivo(texto);
+        arquivo << "Maria Oliveira,maria,3,1,0,0,7,2\n"
+                << "Ana,ana,0,0,12,5,0,0\n"
+                << "José Ávila,zé,1,1,1,1,1,1\n"
+                << "Bia,b,0,0,0,0,0,2147483647\n";
+    }
+    Cadastro original;
+    original.setVerboso(false);
+    original.import(texto);
+    original.saveBinario(binario);
+    CHECK(CadastroBinario::reconhecer(binario));
+    CHECK_FALSE(CadastroBinario::reconhecer(texto));
+
+    // Acesso direto pela posição e pelo apelido, sem carregar o cadastro
+    {
+        CadastroBinario arquivo(binario);
+        REQUIRE(arquivo.tamanho() == 4);
+        CHECK(arquivo.jogador(0).serializar() == "Maria Oliveira,maria,3,1,0,0,7,2");
+        CHECK(arquivo.jogador(3).serializar() == "Bia,b,0,0,0,0,0,2147483647");
+        CHECK(arquivo.procurar("ana") == 1);
+        CHECK(arquivo.procurar("zé") == 2);
+        CHECK(arquivo.procurar("b") == 3);
+        CHECK(arquivo.procurar("mari") == -1);
+        CHECK(arquivo.procurar("") == -1);
+        CHECK_THROWS_AS(arquivo.jogador(4), std::out_of_range);
+    }
+
+    // Ida e volta: o texto regravado a partir do binário é igual ao original
+    Cadastro lido;
+    lido.setVerboso(false);
+    lido.importBinario(binario);
+    REQUIRE(lido.get_jogadores().size() == original.get_jogadores().size());
+    bool iguais = true;
+    for (std::size_t i = 0; i < lido.get_jogadores().size(); i++) {
+        iguais = iguais && lido.get_jogadores()[i]->serializar() == original.get_jogadores()[i]->serializar();
+    }
+    CHECK(iguais);
+    CHECK(lido.find("zé") != nullptr);
+
+    // Cadastro vazio também tem um arquivo válido
+    Cadastro vazio;
+    vazio.setVerboso(false);
+    vazio.saveBinario(binario);
+    lido.importBinario(binario);
+    CHECK(lido.get_jogadores().empty());
+
+    // Arquivos inválidos não são aceitos e deixam o cadastro vazio
+    original.saveBinario(binario);
+    std::string conteudo;
+    {
+        std::ifstream arquivo(binario, std::ios::binary);
+        conteudo.assign(std::istreambuf_iterator<char>(arquivo), std::istreambuf_iterator<char>());
+    }
+    auto regravar = [&binario](const std::string& dados) {
+        std::ofstream arquivo(binario, std::ios::binary | std::ios::trunc);
+        arquivo.write(dados.data(), dados.size());
+    };
+    regravar(conteudo.substr(0, conteudo.size() - 1)); // Área de textos incompleta
+    CHECK_THROWS_AS(lido.importBinario(binario), std::runtime_error);
+    CHECK(lido.get_jogadores().empty());
+    std::string outraVersao = conteudo;
+    outraVersao[4] = 2;
+    regravar(outraVersao);
+    CHECK_THROWS_WITH(CadastroBinario arquivo(binario),
+                      ("Arquivo binário de cadastro inválido (versão não suportada): " + binario).c_str());
+    CHECK_THROWS_AS(lido.importBinario(texto), std::runtime_error);
+    std::remove(binario.c_str());
+    CHECK_THROWS_AS(lido.importBinario(binario), std::runtime_error);
+
+    // Placares negativos não cabem no formato
+    Cadastro negativo;
+    negativo.setVerboso(false);
+    negativo.adicionarJogador(Jogador("Negativo", "neg", -1));
+    CHECK_THROWS_AS(negativo.saveBinario(binario), std::runtime_error);
+    std::remove(texto.c_str());
+    std::remove(binario.c_str());
+}
@@ -0,0 +1,48 @@
+/**
+ * @file threadpool.cpp
+ * @brief Declaração dos métodos da classe ThreadPool.
+ */
+
+#include "threadpool.hpp"
+
+ThreadPool::ThreadPool(int threads) : encerrando_(false) {
+    if (threads < 1) threads = 1;
+    for (int i = 0; i < threads; i++) {
+        threads_.emplace_back(&ThreadPool::trabalhar, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> trava(mutex_);
+        encerrando_ = true;
+    }
+    condicao_.notify_all();
+    for (std::thread& t : threads_) {
+        t.join();
+    }
+}
+
+int ThreadPool::nucleosDisponiveis() {
+    unsigned int nucleos = std::thread::hardware_concurrency();
+    return nucleos == 0 ? 1 : static_cast<int>(nucleos);
+}
+
+/**
+ * @brief Laço de cada thread: retira tarefas da fila até o pool ser destruído e a fila esvaziar.
+ */
+void ThreadPool::trabalhar() {
+    while (true) {
+        std::function<void()> tarefa;
+        {
+            std::unique_lock<std::mutex> trava(mutex_);
+            condicao_.wait(trava, [this]() { return encerrando_ || !fila_.empty(); });
+            if (fila_.empty()) {
+                return;
+            }
+            tarefa = std::move(fila_.front());
+            fila_.pop();
+        }
+        tarefa();
+    }
+}
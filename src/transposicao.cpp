@@ -0,0 +1,141 @@
+/**
+ * @file transposicao.cpp
+ * @brief Declaração dos métodos da classe TabelaTransposicao.
+ */
+
+#include "transposicao.hpp"
+#include <new>
+
+TabelaTransposicao::TabelaTransposicao(std::size_t megabytes)
+    : baldes_(nullptr), total_baldes_(0), megabytes_(0), geracao_(0) {
+    redimensionar(megabytes);
+}
+
+/**
+ * @brief Aloca a maior quantidade de baldes (potência de dois) que cabe no tamanho pedido.
+ * @param megabytes Tamanho da tabela em MB (mínimo de um balde).
+ */
+void TabelaTransposicao::redimensionar(std::size_t megabytes) {
+    std::size_t bytes = megabytes * 1024 * 1024;
+    std::size_t baldes = 1;
+    while (baldes * 2 * sizeof(Balde) <= bytes) {
+        baldes *= 2;
+    }
+
+    memoria_.assign(baldes * sizeof(Balde) + alignof(Balde), 0);
+    std::size_t endereco = reinterpret_cast<std::size_t>(memoria_.data());
+    std::size_t desalinhamento = endereco % alignof(Balde);
+    unsigned char* inicio = memoria_.data() + (desalinhamento ? alignof(Balde) - desalinhamento : 0);
+    baldes_ = reinterpret_cast<Balde*>(inicio);
+    for (std::size_t i = 0; i < baldes; i++) {
+        new (inicio + i * sizeof(Balde)) Balde();
+    }
+    total_baldes_ = baldes;
+    megabytes_ = megabytes;
+    limpar();
+}
+
+void TabelaTransposicao::limpar() {
+    for (std::size_t i = 0; i < total_baldes_; i++) {
+        for (Espaco& e : baldes_[i].entradas) {
+            e.verificacao.store(0, std::memory_order_relaxed);
+            e.dados.store(0, std::memory_order_relaxed);
+        }
+    }
+    geracao_.store(0);
+}
+
+uint64_t TabelaTransposicao::empacotar(const EntradaTT& entrada) {
+    return static_cast<uint64_t>(static_cast<uint32_t>(entrada.pontuacao)) |
+           static_cast<uint64_t>(static_cast<uint8_t>(entrada.profundidade)) << 32 |
+           static_cast<uint64_t>(entrada.tipo_geracao) << 40 |
+           static_cast<uint64_t>(static_cast<uint8_t>(entrada.linha)) << 48 |
+           static_cast<uint64_t>(static_cast<uint8_t>(entrada.coluna)) << 56;
+}
+
+EntradaTT TabelaTransposicao::desempacotar(uint64_t chave, uint64_t dados) {
+    EntradaTT entrada;
+    entrada.chave = chave;
+    entrada.pontuacao = static_cast<int32_t>(static_cast<uint32_t>(dados));
+    entrada.profundidade = static_cast<int8_t>(dados >> 32);
+    entrada.tipo_geracao = static_cast<uint8_t>(dados >> 40);
+    entrada.linha = static_cast<int8_t>(dados >> 48);
+    entrada.coluna = static_cast<int8_t>(dados >> 56);
+    return entrada;
+}
+
+/**
+ * @brief Procura a posição na tabela.
+ * @param chave Hash da posição.
+ * @param entrada Recebe a entrada encontrada.
+ * @return true se a posição estava guardada.
+ */
+bool TabelaTransposicao::consultar(uint64_t chave, EntradaTT& entrada) const {
+    const Balde& b = balde(chave);
+    for (int i = 0; i < ENTRADAS_POR_BALDE; i++) {
+        uint64_t dados = b.entradas[i].dados.load(std::memory_order_relaxed);
+        uint64_t verificacao = b.entradas[i].verificacao.load(std::memory_order_relaxed);
+        if ((verificacao ^ dados) == chave && dados != 0) {
+            entrada = desempacotar(chave, dados);
+            return entrada.tipo() != EntradaTT::VAZIA;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Guarda o resultado de uma busca.
+ * @param chave Hash da posição.
+ * @param profundidade Profundidade restante com que a posição foi avaliada.
+ * @param pontuacao Pontuação encontrada.
+ * @param tipo Se a pontuação é exata ou apenas um limite inferior/superior.
+ * @param linha Linha da melhor jogada (-1 se nenhuma).
+ * @param coluna Coluna da melhor jogada (-1 se nenhuma).
+ */
+void TabelaTransposicao::guardar(uint64_t chave, int profundidade, int pontuacao, EntradaTT::Tipo tipo, int linha, int coluna) {
+    Balde& b = balde(chave);
+    int geracao = geracao_.load(std::memory_order_relaxed);
+    Espaco* alvo = &b.entradas[0];
+    EntradaTT atual;
+    bool mesmaPosicao = false;
+    int menorValor = 1 << 30;
+
+    for (int i = 0; i < ENTRADAS_POR_BALDE; i++) {
+        Espaco& e = b.entradas[i];
+        uint64_t dados = e.dados.load(std::memory_order_relaxed);
+        uint64_t chaveGuardada = e.verificacao.load(std::memory_order_relaxed) ^ dados;
+        EntradaTT existente = desempacotar(chaveGuardada, dados);
+
+        if (chaveGuardada == chave || dados == 0) {
+            alvo = &e;
+            atual = existente;
+            mesmaPosicao = (dados != 0);
+            break;
+        }
+        // Entradas de buscas antigas e de pouca profundidade são as primeiras a sair
+        int idade = (geracao - existente.geracao()) & 63;
+        int valor = existente.profundidade - 8 * idade;
+        if (valor < menorValor) {
+            menorValor = valor;
+            alvo = &e;
+        }
+    }
+
+    // Não troca uma análise mais profunda da mesma posição por uma mais rasa, salvo resultado exato
+    if (mesmaPosicao && tipo != EntradaTT::EXATA &&
+        atual.profundidade > profundidade && atual.geracao() == geracao) {
+        return;
+    }
+
+    EntradaTT nova;
+    nova.chave = chave;
+    nova.pontuacao = pontuacao;
+    nova.profundidade = static_cast<int8_t>(profundidade);
+    nova.tipo_geracao = static_cast<uint8_t>(tipo | (geracao << 2));
+    nova.linha = static_cast<int8_t>(linha);
+    nova.coluna = static_cast<int8_t>(coluna);
+
+    uint64_t dados = empacotar(nova);
+    alvo->verificacao.store(chave ^ dados, std::memory_order_relaxed);
+    alvo->dados.store(dados, std::memory_order_relaxed);
+}